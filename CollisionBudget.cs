@@ -0,0 +1,548 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Text;
+
+namespace SM64CollisionPatcher
+{
+    //How much of a wall the new wall routine pushes out of. Full rounds all three edges, Face only pushes out of the face
+    //and lets the sphere pass the edges like the old routine's projection did.
+    enum WallTier
+    {
+        Full,
+        Face
+    }
+
+    //Estimates how expensive the collision of every level is going to be with the new wall routine, before the ROM is patched.
+    //The level scripts are followed from the entry script to find the collision of every area, which is then split into the
+    //same 16x16 cells the game uses for its static surface partition. The cost of a frame is estimated from the list lengths of
+    //the cells with a rough cycle model of the R4300. The numbers are meant to compare levels and find the ones close to lagging,
+    //they are not exact timings. Object surfaces are not part of the level collision and therefore not included.
+    class CollisionBudget
+    {
+        //The entry level script (segment 0x10) of the US ROM. All other scripts are reached from here.
+        const int EntryScriptROMStart = 0x108A10;
+        const int EntryScriptROMEnd = 0x108A40;
+        const uint EntryScriptAddress = 0x10000000;
+
+        const int NumCells = 16;
+        const int LevelBoundaryMax = 0x2000;
+        const int CellSize = 0x400;
+        const int CellBuffer = 50;
+
+        //One frame at 30 fps of the 93.75 MHz CPU.
+        const double FrameCycles = 93750000.0 / 30.0;
+        //Levels whose busiest cell takes more than this share of a frame for collision are flagged.
+        const double RiskShare = 0.10;
+
+        //Collision queries per frame with Mario and the camera in a cell.
+        //Four quarter steps with two wall checks, a floor and a ceiling each, Mario's geometry update, the camera and the shadow.
+        const int WallQueriesPerFrame = 12;
+        const int FloorQueriesPerFrame = 8;
+        const int CeilQueriesPerFrame = 5;
+
+        //Rough cycle costs. A list node includes the average cost of the data cache misses on the surfaces.
+        const double QueryCycles = 150;
+        const double NodeCycles = 30;
+        const double WallRangeCycles = 8;       //Height check every wall in the list gets
+        const double WallPlaneCycles = 30;      //Distance to the plane for walls at the right height
+        const double WallPlaneHitRate = 0.2;    //Share of those within the radius on either side of the plane
+        const double VanillaWallPushCycles = 60;    //Projection checks and push of the old routine
+        const double PatchedWallPushCycles = 320;   //Face test and three edge checks with sqrt.s of the new routine, front side only
+        const double FaceWallPushCycles = 110;      //Face test and push of the new routine without the edge checks
+        const double FloorCycles = 35;          //Edge checks of floors and ceilings (unchanged by the patch)
+
+        static readonly string[] LevelNames = new string[]
+        {
+            "", "Unknown 1", "Unknown 2", "Unknown 3", "BBH", "CCM", "Castle", "HMC", "SSL", "BOB", "SL", "WDW", "JRB", "THI", "TTC", "RR",
+            "Castle Grounds", "BitDW", "VCutM", "BitFS", "SA", "BitS", "LLL", "DDD", "WF", "Ending", "Castle Courtyard", "PSS", "CotMC",
+            "TotWC", "Bowser 1", "WMotR", "Unknown 32", "Bowser 2", "Bowser 3", "Unknown 35", "TTM", "Unknown 37", "Unknown 38"
+        };
+
+        public class AreaBudget
+        {
+            public int Level;
+            public int Area;
+            public int CollisionROMAddress; //-1 if the collision is compressed
+            public int NumWalls, NumFloors, NumCeils;
+            public int[] CellWalls = new int[NumCells * NumCells];
+            public int[] CellFloors = new int[NumCells * NumCells];
+            public int[] CellCeils = new int[NumCells * NumCells];
+            //Most walls a single wall check at one height has to test beyond the height check.
+            public int[] CellWallCandidates = new int[NumCells * NumCells];
+
+            public int WorstCell = -1;
+            public double VanillaCycles;
+            public double PatchedCycles;
+            public double AveragePatchedCycles;
+
+            public string Name => $"{(Level > 0 && Level < LevelNames.Length ? LevelNames[Level] : "Level " + Level)} ({Area})";
+            public double FrameShare => PatchedCycles / FrameCycles;
+            public bool AtRisk => FrameShare > RiskShare;
+        }
+
+        class Segment
+        {
+            public byte[] Data;
+            public int Start;
+            public int Length;
+            public int ROMStart;
+            public bool Compressed;
+        }
+
+        byte[] rom;
+        int boundaryScale;
+        WallTier tier;
+        double wallThreshold;
+        Dictionary<int, byte[]> decompressed = new Dictionary<int, byte[]>();
+        HashSet<string> visited = new HashSet<string>();
+        HashSet<string> foundAreas = new HashSet<string>();
+        List<AreaBudget> areas = new List<AreaBudget>();
+        int commandsLeft = 1000000;
+
+        CollisionBudget(byte[] rom, int boundaryScale, WallTier tier, double wallThreshold)
+        {
+            this.rom = rom;
+            this.boundaryScale = boundaryScale;
+            this.tier = tier;
+            this.wallThreshold = wallThreshold;
+        }
+
+        //Finds the collision of every level area in the ROM and estimates its cost.
+        //boundaryScale is the factor the level boundaries and cells are enlarged by (1 for regular boundaries).
+        //tier is the wall routine the ROM is patched with.
+        //wallThreshold is the largest y-component of the normal of a wall triangle.
+        public static List<AreaBudget> Analyze(byte[] rom, int boundaryScale, WallTier tier, double wallThreshold)
+        {
+            var readError = CheckReadSurfaces();
+            if (readError != null)
+                throw new Exception(readError);
+
+            var budget = new CollisionBudget(rom, boundaryScale, tier, wallThreshold);
+            var segments = new Segment[0x20];
+            segments[0x10] = budget.LoadSegment(EntryScriptROMStart, EntryScriptROMEnd, false);
+            budget.Walk(segments, EntryScriptAddress, 0, 0);
+            budget.areas.Sort((a, b) => a.Level != b.Level ? a.Level.CompareTo(b.Level) : a.Area.CompareTo(b.Area));
+            return budget.areas;
+        }
+
+        static int Read16(byte[] data, int offset) => (short)((data[offset] << 8) | data[offset + 1]);
+        static uint Read32(byte[] data, int offset) => (uint)((data[offset] << 24) | (data[offset + 1] << 16) | (data[offset + 2] << 8) | data[offset + 3]);
+
+        //Decompresses an MIO0 block at the given ROM address.
+        static byte[] DecompressMIO0(byte[] src, int start)
+        {
+            if (Read32(src, start) != 0x4D494F30) //"MIO0"
+                return null;
+            var size = (int)Read32(src, start + 4);
+            if (size < 0 || size > 0x1000000)
+                return null;
+            var compressedOffset = start + (int)Read32(src, start + 8);
+            var rawOffset = start + (int)Read32(src, start + 12);
+            var layoutOffset = start + 16;
+            var dest = new byte[size];
+            uint layout = 0;
+            int bitsLeft = 0;
+
+            for (int i = 0; i < size; )
+            {
+                if (bitsLeft == 0)
+                {
+                    layout = Read32(src, layoutOffset);
+                    layoutOffset += 4;
+                    bitsLeft = 32;
+                }
+                if ((layout & 0x80000000) != 0)
+                    dest[i++] = src[rawOffset++];
+                else
+                {
+                    var backReference = (src[compressedOffset] << 8) | src[compressedOffset + 1];
+                    compressedOffset += 2;
+                    var length = (backReference >> 12) + 3;
+                    var from = i - (backReference & 0xFFF) - 1;
+                    for (int k = 0; k < length && i < size; k++)
+                        dest[i++] = dest[from + k];
+                }
+                layout <<= 1;
+                bitsLeft--;
+            }
+            return dest;
+        }
+
+        Segment LoadSegment(int romStart, int romEnd, bool mayBeCompressed)
+        {
+            if (romStart < 0 || romEnd > rom.Length || romEnd <= romStart)
+                return null;
+
+            //Extended ROMs may still use the compressed load commands for data that was decompressed, so only decompress MIO0 blocks.
+            if (mayBeCompressed && Read32(rom, romStart) == 0x4D494F30)
+            {
+                byte[] data;
+                if (!decompressed.TryGetValue(romStart, out data))
+                {
+                    try
+                    {
+                        data = DecompressMIO0(rom, romStart);
+                    }
+                    catch (IndexOutOfRangeException)
+                    {
+                        data = null;
+                    }
+                    decompressed[romStart] = data;
+                }
+                if (data == null)
+                    return null;
+                return new Segment { Data = data, Start = 0, Length = data.Length, ROMStart = romStart, Compressed = true };
+            }
+            return new Segment { Data = rom, Start = romStart, Length = romEnd - romStart, ROMStart = romStart };
+        }
+
+        //Returns the segment and the offset into its data of a segmented address, or null if it cannot be resolved.
+        static Segment Resolve(Segment[] segments, uint address, out int offset)
+        {
+            offset = 0;
+            var segment = address >> 24;
+            if (segment >= 0x20 || segments[segment] == null || (address & 0xFFFFFF) >= segments[segment].Length)
+                return null;
+            offset = segments[segment].Start + (int)(address & 0xFFFFFF);
+            return segments[segment];
+        }
+
+        //Follows a level script and every branch it could take, recording the collision of every area.
+        //level is the level number the script was reached for, as far as known from the level table.
+        void Walk(Segment[] segments, uint address, int level, int depth)
+        {
+            int offset;
+            var segment = Resolve(segments, address, out offset);
+            if (segment == null || depth > 32)
+                return;
+
+            int area = 0;
+            var end = segment.Start + segment.Length;
+            while (offset + 4 <= end && commandsLeft-- > 0)
+            {
+                if (!visited.Add($"{segment.ROMStart:X}:{segment.Compressed}:{offset:X}:{level}"))
+                    return;
+
+                var data = segment.Data;
+                var command = data[offset];
+                var length = data[offset + 1];
+                if (length < 4 || offset + length > end)
+                    return;
+
+                switch (command)
+                {
+                    case 0x00: //EXECUTE
+                    case 0x01: //EXIT_AND_EXECUTE
+                        {
+                            var newSegments = (Segment[])segments.Clone();
+                            newSegments[data[offset + 3] & 0x1F] = LoadSegment((int)Read32(data, offset + 4), (int)Read32(data, offset + 8), false);
+                            Walk(newSegments, Read32(data, offset + 12), level, depth + 1);
+                            if (command == 0x01)
+                                return;
+                            break;
+                        }
+                    case 0x02: //EXIT
+                    case 0x07: //RETURN
+                        return;
+                    case 0x05: //JUMP
+                        Walk(segments, Read32(data, offset + 4), level, depth + 1);
+                        return;
+                    case 0x06: //JUMP_LINK
+                        Walk(segments, Read32(data, offset + 4), level, depth + 1);
+                        break;
+                    case 0x0C: //JUMP_IF
+                    case 0x0D: //JUMP_LINK_IF
+                        //The level table jumps to the script of every level with JUMP_IF(OP_EQ, level, ...)
+                        var jumpLevel = data[offset + 2] == 2 ? (int)Read32(data, offset + 4) : level;
+                        Walk(segments, Read32(data, offset + 8), jumpLevel, depth + 1);
+                        break;
+                    case 0x17: //LOAD_RAW
+                    case 0x18: //LOAD_MIO0
+                    case 0x1A: //LOAD_MIO0_TEXTURE
+                        segments[data[offset + 3] & 0x1F] = LoadSegment((int)Read32(data, offset + 4), (int)Read32(data, offset + 8), command != 0x17);
+                        break;
+                    case 0x1F: //AREA
+                        area = data[offset + 2];
+                        break;
+                    case 0x20: //END_AREA
+                        area = 0;
+                        break;
+                    case 0x2E: //TERRAIN
+                        AddArea(segments, Read32(data, offset + 4), level, area);
+                        break;
+                }
+                offset += length;
+            }
+        }
+
+        static int LowerCell(int coord, int boundary, int cellSize)
+        {
+            coord += boundary;
+            if (coord < 0)
+                coord = 0;
+            var index = coord / cellSize;
+            if (coord % cellSize < CellBuffer)
+                index--;
+            return index < 0 ? 0 : index;
+        }
+
+        static int UpperCell(int coord, int boundary, int cellSize)
+        {
+            coord += boundary;
+            if (coord < 0)
+                coord = 0;
+            var index = coord / cellSize;
+            if (coord % cellSize > cellSize - CellBuffer)
+                index++;
+            return index > NumCells - 1 ? NumCells - 1 : index;
+        }
+
+        static bool SurfaceHasForce(int type) =>
+            type == 0x04 || type == 0x0E || type == 0x24 || type == 0x25 || type == 0x27 || type == 0x2C || type == 0x2D;
+
+        //Walks the commands of an area's collision data like load_area_terrain does and passes the vertices of every surface
+        //to addSurface. Each group of surfaces of one type ends with TERRAIN_LOAD_CONTINUE, the data with TERRAIN_LOAD_END.
+        //The surfaces come before the special objects and environment regions, whose sizes are not needed, so the walk also
+        //stops at those.
+        static void ReadSurfaces(byte[] data, int offset, int end, Action<int[], int[], int[]> addSurface)
+        {
+            int numVertices = 0;
+            var vertexOffset = 0;
+
+            while (offset + 2 <= end)
+            {
+                var type = Read16(data, offset) & 0xFFFF;
+                offset += 2;
+                if (type == 0x40) //TERRAIN_LOAD_VERTICES
+                {
+                    if (offset + 2 > end)
+                        return;
+                    numVertices = Read16(data, offset) & 0xFFFF;
+                    vertexOffset = offset + 2;
+                    offset = vertexOffset + 6 * numVertices;
+                    continue;
+                }
+                if (type == 0x42 || type == 0x43 || type == 0x44) //TERRAIN_LOAD_END, TERRAIN_LOAD_OBJECTS, TERRAIN_LOAD_ENVIRONMENT
+                    return;
+                //TERRAIN_LOAD_CONTINUE, and the commands load_area_terrain ignores
+                if (type >= 0x41 && type < 0x65)
+                    continue;
+                if (offset + 2 > end)
+                    return;
+
+                var numSurfaces = Read16(data, offset) & 0xFFFF;
+                var stride = SurfaceHasForce(type) ? 8 : 6;
+                offset += 2;
+                if (offset + numSurfaces * stride > end)
+                    return;
+
+                for (int i = 0; i < numSurfaces; i++, offset += stride)
+                {
+                    int[] x = new int[3], y = new int[3], z = new int[3];
+                    bool valid = true;
+                    for (int k = 0; k < 3; k++)
+                    {
+                        var index = Read16(data, offset + 2 * k) & 0xFFFF;
+                        if (index >= numVertices)
+                            valid = false;
+                        else
+                        {
+                            x[k] = Read16(data, vertexOffset + 6 * index);
+                            y[k] = Read16(data, vertexOffset + 6 * index + 2);
+                            z[k] = Read16(data, vertexOffset + 6 * index + 4);
+                        }
+                    }
+                    if (valid)
+                        addSurface(x, y, z);
+                }
+            }
+        }
+
+        //Checks ReadSurfaces on collision data with several surface types, one with force, and the commands after them.
+        //Returns an error message, or null if every surface was found.
+        static string CheckReadSurfaces()
+        {
+            var words = new int[]
+            {
+                0x40, 3, 0, 0, 0, 100, 0, 0, 0, 0, 100,
+                0x00, 2, 0, 1, 2, 0, 2, 1, 0x41,          //SURFACE_DEFAULT
+                0x0E, 1, 0, 1, 2, 0x10, 0x41,             //SURFACE_FLOWING_WATER, with force
+                0x0A, 1, 0, 2, 1, 0x41,                   //SURFACE_VERY_SLIPPERY
+                0x65, 1, 1, 2, 0, 0x41,                   //SURFACE_WALL_MISC
+                0x44, 0, 0x42, 0x00, 1, 0, 1, 2
+            };
+            var data = new byte[words.Length * 2];
+            for (int i = 0; i < words.Length; i++)
+            {
+                data[2 * i] = (byte)(words[i] >> 8);
+                data[2 * i + 1] = (byte)words[i];
+            }
+
+            int numSurfaces = 0;
+            ReadSurfaces(data, 0, data.Length, (x, y, z) => numSurfaces++);
+            return numSurfaces == 5 ? null : $"Reading the surfaces of test collision data found {numSurfaces} of 5 surfaces.";
+        }
+
+        //Reads the surfaces of an area's collision data and adds them to the cells like load_area_terrain does.
+        void AddArea(Segment[] segments, uint address, int level, int area)
+        {
+            int offset;
+            var segment = Resolve(segments, address, out offset);
+            if (segment == null || !foundAreas.Add($"{level}:{area}:{segment.ROMStart:X}:{offset:X}"))
+                return;
+
+            var budget = new AreaBudget { Level = level, Area = area, CollisionROMAddress = segment.Compressed ? -1 : offset };
+            var wallRanges = new List<int>[NumCells * NumCells];
+            var boundary = LevelBoundaryMax * boundaryScale;
+            var cellSize = CellSize * boundaryScale;
+            var data = segment.Data;
+            var end = segment.Start + segment.Length;
+
+            ReadSurfaces(data, offset, end, (x, y, z) =>
+            {
+                //(v2 - v1) x (v3 - v2), as in read_surface_data
+                double nx = (double)(y[1] - y[0]) * (z[2] - z[1]) - (double)(z[1] - z[0]) * (y[2] - y[1]);
+                double ny = (double)(z[1] - z[0]) * (x[2] - x[1]) - (double)(x[1] - x[0]) * (z[2] - z[1]);
+                double nz = (double)(x[1] - x[0]) * (y[2] - y[1]) - (double)(y[1] - y[0]) * (x[2] - x[1]);
+                var mag = Math.Sqrt(nx * nx + ny * ny + nz * nz);
+                if (mag < 0.0001)
+                    return;
+                ny /= mag;
+
+                var minCellX = LowerCell(Math.Min(x[0], Math.Min(x[1], x[2])), boundary, cellSize);
+                var maxCellX = UpperCell(Math.Max(x[0], Math.Max(x[1], x[2])), boundary, cellSize);
+                var minCellZ = LowerCell(Math.Min(z[0], Math.Min(z[1], z[2])), boundary, cellSize);
+                var maxCellZ = UpperCell(Math.Max(z[0], Math.Max(z[1], z[2])), boundary, cellSize);
+                var lowerY = Math.Min(y[0], Math.Min(y[1], y[2])) - 5;
+                var upperY = Math.Max(y[0], Math.Max(y[1], y[2])) + 5;
+
+                if (ny > wallThreshold)
+                    budget.NumFloors++;
+                else if (ny < -wallThreshold)
+                    budget.NumCeils++;
+                else
+                    budget.NumWalls++;
+
+                for (int cellZ = minCellZ; cellZ <= maxCellZ; cellZ++)
+                    for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+                    {
+                        var cell = cellZ * NumCells + cellX;
+                        if (ny > wallThreshold)
+                            budget.CellFloors[cell]++;
+                        else if (ny < -wallThreshold)
+                            budget.CellCeils[cell]++;
+                        else
+                        {
+                            budget.CellWalls[cell]++;
+                            if (wallRanges[cell] == null)
+                                wallRanges[cell] = new List<int>();
+                            //Starts of the height ranges are even, ends odd so that they sort after starts at the same height.
+                            wallRanges[cell].Add(lowerY * 2);
+                            wallRanges[cell].Add(upperY * 2 + 1);
+                        }
+                    }
+            });
+
+            for (int cell = 0; cell < NumCells * NumCells; cell++)
+            {
+                if (wallRanges[cell] == null)
+                    continue;
+                wallRanges[cell].Sort();
+                int count = 0;
+                foreach (var edge in wallRanges[cell])
+                {
+                    count += (edge & 1) == 0 ? 1 : -1;
+                    if (count > budget.CellWallCandidates[cell])
+                        budget.CellWallCandidates[cell] = count;
+                }
+            }
+
+            Estimate(budget, WallPushCycles(tier));
+            areas.Add(budget);
+        }
+
+        //Cycles the new routine takes for a wall in front of the sphere within its radius.
+        public static double WallPushCycles(WallTier tier) => tier == WallTier.Face ? FaceWallPushCycles : PatchedWallPushCycles;
+
+        static double WallQueryCycles(int walls, int candidates, double pushCycles, double hitRate) =>
+            QueryCycles + walls * (NodeCycles + WallRangeCycles) + candidates * (WallPlaneCycles + hitRate * pushCycles);
+
+        static double ListQueryCycles(int surfaces) => QueryCycles + surfaces * (NodeCycles + FloorCycles);
+
+        //Finds the most expensive cell and the average over the cells with floors, where Mario can be.
+        static void Estimate(AreaBudget budget, double pushCycles)
+        {
+            double total = 0;
+            int numFloorCells = 0;
+            for (int cell = 0; cell < NumCells * NumCells; cell++)
+            {
+                if (budget.CellFloors[cell] == 0)
+                    continue;
+
+                var floorAndCeil = FloorQueriesPerFrame * ListQueryCycles(budget.CellFloors[cell]) + CeilQueriesPerFrame * ListQueryCycles(budget.CellCeils[cell]);
+                var vanilla = floorAndCeil + WallQueriesPerFrame * WallQueryCycles(budget.CellWalls[cell], budget.CellWallCandidates[cell], VanillaWallPushCycles, WallPlaneHitRate);
+                //The new routine skips the back of walls, so only half as many walls get to the push.
+                var patched = floorAndCeil + WallQueriesPerFrame * WallQueryCycles(budget.CellWalls[cell], budget.CellWallCandidates[cell], pushCycles, WallPlaneHitRate / 2);
+
+                if (patched > budget.PatchedCycles)
+                {
+                    budget.WorstCell = cell;
+                    budget.PatchedCycles = patched;
+                    budget.VanillaCycles = vanilla;
+                }
+                total += patched;
+                numFloorCells++;
+            }
+            if (numFloorCells > 0)
+                budget.AveragePatchedCycles = total / numFloorCells;
+        }
+
+        static void ListStats(int[] cells, out int max, out double average)
+        {
+            max = 0;
+            int sum = 0, occupied = 0;
+            foreach (var count in cells)
+            {
+                if (count > max)
+                    max = count;
+                if (count > 0)
+                {
+                    sum += count;
+                    occupied++;
+                }
+            }
+            average = occupied > 0 ? (double)sum / occupied : 0;
+        }
+
+        //Prints the surface counts and list lengths of every area along with the estimated collision cost per frame.
+        //If onlyAtRisk is set, only the areas that risk lag are printed.
+        public static void PrintReport(List<AreaBudget> areas, bool onlyAtRisk)
+        {
+            var builder = new StringBuilder();
+            builder.AppendLine($"{"Level (area)",-24} {"Walls",6} {"Floors",6} {"Ceils",6} | {"Walls/cell",11} {"Floors/cell",11} {"Ceils/cell",11} | {"Worst cell",10} {"Vanilla",8} {"Patched",8} {"Frame",6} {"Average",6}");
+            builder.AppendLine($"{"",-24} {"",6} {"",6} {"",6} | {"max   avg",11} {"max   avg",11} {"max   avg",11} | {"x,z (walls)",10} {"cycles",8} {"cycles",8} {"share",6} {"share",6}");
+            int shown = 0;
+            foreach (var area in areas)
+            {
+                if (onlyAtRisk && !area.AtRisk)
+                    continue;
+                int maxWalls, maxFloors, maxCeils;
+                double averageWalls, averageFloors, averageCeils;
+                ListStats(area.CellWalls, out maxWalls, out averageWalls);
+                ListStats(area.CellFloors, out maxFloors, out averageFloors);
+                ListStats(area.CellCeils, out maxCeils, out averageCeils);
+                var worst = area.WorstCell < 0 ? "-" : $"{area.WorstCell % NumCells},{area.WorstCell / NumCells} ({area.CellWallCandidates[area.WorstCell]})";
+
+                builder.AppendLine($"{area.Name,-24} {area.NumWalls,6} {area.NumFloors,6} {area.NumCeils,6} | " +
+                    $"{maxWalls,4} {averageWalls,6:F1} {maxFloors,4} {averageFloors,6:F1} {maxCeils,4} {averageCeils,6:F1} | " +
+                    $"{worst,10} {area.VanillaCycles,8:F0} {area.PatchedCycles,8:F0} {area.FrameShare * 100,5:F0}% {area.AveragePatchedCycles / FrameCycles * 100,5:F0}%" +
+                    (area.AtRisk ? "  at risk of lag" : ""));
+                shown++;
+            }
+            if (shown > 0)
+                Console.Write(builder.ToString());
+            Console.WriteLine($"Cycles are estimated for Mario and the camera in the most expensive cell, out of {FrameCycles:F0} cycles per frame at 30 fps.");
+            Console.WriteLine($"Areas whose collision may take more than {RiskShare * 100:F0}% of a frame are at risk of lag. Walls in brackets are the most a wall check tests at one height.");
+        }
+    }
+}
@@ -0,0 +1,284 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Text;
+
+namespace SM64CollisionPatcher
+{
+    //Runs the patched find_wall_collisions_from_list in the R4300 interpreter against synthetic surface lists with known results,
+    //and checks that the JALs of the written subroutines lead to functions. This catches payloads that were assembled or
+    //relocated wrong, and reports how many instructions the new wall routine takes, without booting the ROM in an emulator.
+    class PayloadCheck
+    {
+        //Segments of the US ROM that the patched code runs against: main (with sqrtf), engine (with the collision constants)
+        //and the free space the new subroutines are written to.
+        const int MainROMStart = 0x1000;
+        const int MainROMEnd = 0xF5580;
+        const uint MainRAMStart = 0x80246000;
+        const int EngineROMStart = 0xF5580;
+        const int EngineROMEnd = 0x108A10;
+        const uint EngineRAMStart = 0x80378800;
+        const int PatchROMStart = 0x1200000;
+        const int PatchROMEnd = 0x1210000;
+        const uint PatchRAMStart = 0x80400000;
+
+        const uint StackTop = 0x807FFF00;
+        const uint DataStart = 0x80600000;
+        const long MaxInstructions = 1000000;
+
+        //Synthetic walls go to DataStart, followed by their list nodes and the WallCollisionData.
+        const int SurfaceSize = 0x30;
+        const int NodeSize = 0x8;
+
+        class Wall
+        {
+            public short[] Vertices; //x, y, z of the three vertices
+        }
+
+        class Scenario
+        {
+            public string Name;
+            public List<Wall> Walls = new List<Wall>();
+            public float X, Y, Z, OffsetY, Radius;
+            //Expected result, NaN for no check of the coordinate.
+            public float ExpectedX, ExpectedZ;
+            public int ExpectedWalls;
+            public int FirstHit; //Index of the wall expected in walls[0]
+            //Position of a vertical edge the sphere is expected to end up (radius - 1) away from.
+            public bool CheckEdgeDistance;
+            public float EdgeX, EdgeZ;
+        }
+
+        R4300 cpu = new R4300();
+        int scale;
+        uint nextData;
+
+        PayloadCheck(byte[] rom, int scale)
+        {
+            this.scale = scale;
+            cpu.Load(rom, MainROMStart, MainROMEnd, MainRAMStart);
+            cpu.Load(rom, EngineROMStart, EngineROMEnd, EngineRAMStart);
+            cpu.Load(rom, PatchROMStart, Math.Min(PatchROMEnd, rom.Length), PatchRAMStart);
+        }
+
+        //Adds the two triangles of a vertical rectangle from (x1, z1) to (x2, z2) between the heights y1 and y2.
+        //The normal of the wall points to (z1 - z2, 0, x2 - x1). The first triangle has the vertical edge at (x2, z2).
+        static void AddQuad(Scenario scenario, int x1, int z1, int x2, int z2, int y1, int y2)
+        {
+            scenario.Walls.Add(new Wall { Vertices = new short[] { (short)x1, (short)y1, (short)z1, (short)x2, (short)y1, (short)z2, (short)x2, (short)y2, (short)z2 } });
+            scenario.Walls.Add(new Wall { Vertices = new short[] { (short)x1, (short)y1, (short)z1, (short)x2, (short)y2, (short)z2, (short)x1, (short)y2, (short)z1 } });
+        }
+
+        static Scenario NewScenario(string name, float x, float y, float z, float radius, float expectedX, float expectedZ, int expectedWalls)
+        {
+            return new Scenario { Name = name, X = x, Y = y, Z = z, Radius = radius, ExpectedX = expectedX, ExpectedZ = expectedZ, ExpectedWalls = expectedWalls };
+        }
+
+        //The scenarios in world units. Walls are scaled down by the boundary scale when written, like in extended boundary ROMs.
+        //Without edge rounding, the spheres next to an edge are expected to stay where they are.
+        static List<Scenario> BuildScenarios(bool roundsEdges)
+        {
+            var scenarios = new List<Scenario>();
+
+            var face = NewScenario("Face push", 0, 100, 20, 50, 0, 50, 1);
+            AddQuad(face, -512, 0, 512, 0, 0, 512);
+            scenarios.Add(face);
+
+            var back = NewScenario("Behind wall", 0, 100, -20, 50, 0, -20, 0);
+            AddQuad(back, -512, 0, 512, 0, 0, 512);
+            scenarios.Add(back);
+
+            var above = NewScenario("Above wall", 0, 100, 20, 50, 0, 20, 0);
+            above.OffsetY = 500;
+            AddQuad(above, -512, 0, 512, 0, 0, 512);
+            scenarios.Add(above);
+
+            var far = NewScenario("Out of radius", 0, 100, 60, 50, 0, 60, 0);
+            AddQuad(far, -512, 0, 512, 0, 0, 512);
+            scenarios.Add(far);
+
+            //Pushed away from the edge mostly along the normal, which counts as hitting the wall.
+            var edge = roundsEdges ? NewScenario("Edge push", 520, 100, 40, 50, float.NaN, float.NaN, 1) : NewScenario("Edge push", 520, 100, 40, 50, 520, 40, 0);
+            AddQuad(edge, -512, 0, 512, 0, 0, 512);
+            edge.CheckEdgeDistance = roundsEdges;
+            edge.EdgeX = 512;
+            edge.EdgeZ = 0;
+            scenarios.Add(edge);
+
+            //Pushed away from the edge mostly sideways, which moves the sphere around the corner without a wall hit.
+            var slide = roundsEdges ? NewScenario("Edge slide", 536, 100, 8, 50, float.NaN, float.NaN, 0) : NewScenario("Edge slide", 536, 100, 8, 50, 536, 8, 0);
+            AddQuad(slide, -512, 0, 512, 0, 0, 512);
+            slide.CheckEdgeDistance = roundsEdges;
+            slide.EdgeX = 512;
+            slide.EdgeZ = 0;
+            scenarios.Add(slide);
+
+            var corner = NewScenario("Inside corner", 24, 100, 24, 50, 50, 50, 2);
+            AddQuad(corner, -512, 0, 512, 0, 0, 512);
+            AddQuad(corner, 0, 512, 0, -512, 0, 512);
+            scenarios.Add(corner);
+
+            //A long list of walls out of height range in front of the one that is hit, to time the early rejection.
+            var heightRejects = NewScenario("256 height rejects", 0, 100, 20, 50, 0, 50, 1);
+            for (int i = 0; i < 128; i++)
+                AddQuad(heightRejects, -512, -8 * i, 512, -8 * i, 1024, 1536);
+            AddQuad(heightRejects, -512, 0, 512, 0, 0, 512);
+            heightRejects.FirstHit = 256;
+            scenarios.Add(heightRejects);
+
+            //A long list of walls the sphere is behind, to time the plane distance rejection.
+            var planeRejects = NewScenario("256 plane rejects", 0, 100, 20, 50, 0, 50, 1);
+            for (int i = 0; i < 128; i++)
+                AddQuad(planeRejects, -512, 200 + 8 * i, 512, 200 + 8 * i, 0, 512);
+            AddQuad(planeRejects, -512, 0, 512, 0, 0, 512);
+            planeRejects.FirstHit = 256;
+            scenarios.Add(planeRejects);
+
+            return scenarios;
+        }
+
+        //Writes a wall like read_surface_data does, scaled down by the boundary scale.
+        uint WriteSurface(Wall wall)
+        {
+            var address = nextData;
+            nextData += SurfaceSize;
+            var v = new int[9];
+            for (int i = 0; i < 9; i++)
+                v[i] = wall.Vertices[i] / scale;
+
+            float nx = (v[4] - v[1]) * (v[8] - v[5]) - (v[5] - v[2]) * (v[7] - v[4]);
+            float ny = (v[5] - v[2]) * (v[6] - v[3]) - (v[3] - v[0]) * (v[8] - v[5]);
+            float nz = (v[3] - v[0]) * (v[7] - v[4]) - (v[4] - v[1]) * (v[6] - v[3]);
+            var mag = (float)(1.0 / Math.Sqrt(nx * nx + ny * ny + nz * nz));
+            nx *= mag;
+            ny *= mag;
+            nz *= mag;
+
+            for (int i = 0; i < SurfaceSize; i += 4)
+                cpu.Write32(address + (uint)i, 0);
+            cpu.Write16(address + 0x06, (ushort)(Math.Min(v[1], Math.Min(v[4], v[7])) - 5)); //lowerY
+            cpu.Write16(address + 0x08, (ushort)(Math.Max(v[1], Math.Max(v[4], v[7])) + 5)); //upperY
+            for (int i = 0; i < 9; i++)
+                cpu.Write16(address + 0x0A + (uint)(2 * i), (ushort)v[i]);
+            cpu.WriteFloat(address + 0x1C, nx);
+            cpu.WriteFloat(address + 0x20, ny);
+            cpu.WriteFloat(address + 0x24, nz);
+            cpu.WriteFloat(address + 0x28, -(nx * v[0] + ny * v[1] + nz * v[2]));
+            return address;
+        }
+
+        //Runs a scenario and returns an empty string if the result is as expected, or a description of the difference.
+        string RunScenario(Scenario scenario, uint wallRoutine, StringBuilder report)
+        {
+            nextData = DataStart;
+            var surfaces = new List<uint>();
+            foreach (var wall in scenario.Walls)
+                surfaces.Add(WriteSurface(wall));
+
+            uint list = 0;
+            for (int i = surfaces.Count - 1; i >= 0; i--)
+            {
+                var node = nextData;
+                nextData += NodeSize;
+                cpu.Write32(node, list);
+                cpu.Write32(node + 4, surfaces[i]);
+                list = node;
+            }
+
+            var data = nextData;
+            nextData += 0x28;
+            cpu.WriteFloat(data + 0x00, scenario.X);
+            cpu.WriteFloat(data + 0x04, scenario.Y);
+            cpu.WriteFloat(data + 0x08, scenario.Z);
+            cpu.WriteFloat(data + 0x0C, scenario.OffsetY);
+            cpu.WriteFloat(data + 0x10, scenario.Radius);
+            cpu.Write32(data + 0x14, 0);
+            for (uint i = 0x18; i < 0x28; i += 4)
+                cpu.Write32(data + i, 0);
+
+            cpu.ResetCounters();
+            var result = (int)cpu.Call(wallRoutine, StackTop, MaxInstructions, list, data);
+            var x = cpu.ReadFloat(data + 0x00);
+            var z = cpu.ReadFloat(data + 0x08);
+            var numWalls = (short)cpu.Read16(data + 0x16);
+
+            report.AppendLine($"{scenario.Name,-20} {surfaces.Count,5} {result,4} {x,9:F2} {z,9:F2} {cpu.Instructions,8} {(double)cpu.Instructions / surfaces.Count,8:F1} {cpu.FPUOps,7} {cpu.FPUDivSqrt,8} {cpu.Loads + cpu.Stores,7}");
+
+            var tolerance = 0.05f * scale;
+            var errors = new StringBuilder();
+            if (result != scenario.ExpectedWalls || numWalls != Math.Min(scenario.ExpectedWalls, 4))
+                errors.Append($"{result} walls instead of {scenario.ExpectedWalls}. ");
+            if (!float.IsNaN(scenario.ExpectedX) && Math.Abs(x - scenario.ExpectedX) > tolerance)
+                errors.Append($"x is {x:F2} instead of {scenario.ExpectedX:F2}. ");
+            if (!float.IsNaN(scenario.ExpectedZ) && Math.Abs(z - scenario.ExpectedZ) > tolerance)
+                errors.Append($"z is {z:F2} instead of {scenario.ExpectedZ:F2}. ");
+            if (scenario.CheckEdgeDistance)
+            {
+                var distance = Math.Sqrt((x - scenario.EdgeX) * (x - scenario.EdgeX) + (z - scenario.EdgeZ) * (z - scenario.EdgeZ));
+                if (Math.Abs(distance - (scenario.Radius - 1)) > tolerance)
+                    errors.Append($"{distance:F2} away from the edge instead of {scenario.Radius - 1:F2}. ");
+            }
+            if (scenario.ExpectedWalls > 0 && numWalls > 0 && cpu.Read32(data + 0x18) != surfaces[scenario.FirstHit])
+                errors.Append("The first wall reported is not the first wall hit. ");
+            return errors.ToString();
+        }
+
+        //Returns whether the function at a RAM address looks like the start of a function with a stack frame.
+        bool StartsStackFrame(uint address) => (cpu.Read32(address) & 0xFFFF8000) == 0x27BD8000; //addiu sp, sp, -n
+
+        bool IsLoadedCode(uint address) =>
+            (address >= MainRAMStart && address < MainRAMStart + (MainROMEnd - MainROMStart)) ||
+            (address >= EngineRAMStart && address < EngineRAMStart + (EngineROMEnd - EngineROMStart)) ||
+            (address >= PatchRAMStart && address < PatchRAMStart + (PatchROMEnd - PatchROMStart));
+
+        //Checks every JAL of the code at [start, start + length): the target must be loaded code, and targets in the free space
+        //(the relocated perform_air_step dependencies) must start a stack frame.
+        void CheckJALs(string name, uint start, int length, StringBuilder errors)
+        {
+            for (uint address = start; address < start + length; address += 4)
+            {
+                var instruction = cpu.Read32(address);
+                if (instruction >> 26 != 3)
+                    continue;
+                var target = ((address + 4) & 0xF0000000) | ((instruction & 0x3FFFFFF) << 2) | 0x80000000;
+                var targetInstruction = IsLoadedCode(target) ? cpu.Read32(target) : 0;
+                if (!IsLoadedCode(target) || targetInstruction == 0 || targetInstruction == 0x01010101)
+                    errors.AppendLine($"JAL at {address.ToString("X8")} in {name} leads to {target.ToString("X8")}, which is not code.");
+                else if (target >= PatchRAMStart && !StartsStackFrame(target))
+                    errors.AppendLine($"JAL at {address.ToString("X8")} in {name} leads to {target.ToString("X8")}, which is not the start of a function.");
+            }
+        }
+
+        //Runs the checks against the patched ROM. wallRoutine is the RAM address of the new find_wall_collisions_from_list,
+        //scale the factor the level geometry is scaled down by (1 for regular boundaries), roundsEdges whether the routine
+        //pushes out of the edges of walls. The payloads are given with their RAM addresses to check their JALs.
+        //Prints a report and returns the problems found, or an empty string.
+        public static string Run(byte[] rom, uint wallRoutine, int scale, bool roundsEdges, Dictionary<string, KeyValuePair<uint, int>> payloads)
+        {
+            var check = new PayloadCheck(rom, scale);
+            var report = new StringBuilder();
+            var errors = new StringBuilder();
+
+            report.AppendLine($"{"Wall scenario",-20} {"Walls",5} {"Hits",4} {"x",9} {"z",9} {"Instr.",8} {"/wall",8} {"FPU ops",7} {"Div/sqrt",8} {"Mem ops",7}");
+            foreach (var scenario in BuildScenarios(roundsEdges))
+            {
+                string error;
+                try
+                {
+                    error = check.RunScenario(scenario, wallRoutine, report);
+                }
+                catch (Exception ex)
+                {
+                    error = ex.Message;
+                }
+                if (error.Length > 0)
+                    errors.AppendLine($"Wall scenario \"{scenario.Name}\" failed: {error}");
+            }
+
+            foreach (var payload in payloads)
+                check.CheckJALs(payload.Key, payload.Value.Key, payload.Value.Value, errors);
+
+            Console.Write(report.ToString());
+            return errors.ToString();
+        }
+    }
+}
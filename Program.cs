@@ -7,12 +7,12 @@ namespace SM64CollisionPatcher
     {
         static byte[] find_wall_collisions_from_list_ext_bounds = new byte[]
         {
-            0x27, 0xBD, 0xFF, 0x20, 0xAF, 0xBF, 0x00, 0x54, 0xAF, 0xB3, 0x00, 0x50, 0xAF, 0xB2, 0x00, 0x4C, 0xAF, 0xB1, 0x00, 0x48, 0xAF, 0xB0, 0x00, 0x44, 0xF7, 0xBE, 0x00, 0x38, 0xF7, 0xBC, 0x00, 0x30, 0xF7, 0xBA, 0x00, 0x28, 0xF7, 0xB8, 0x00, 0x20, 0xF7, 0xB6, 0x00, 0x18, 0xF7, 0xB4, 0x00, 0x10, 0xC4, 0xAA, 0x00, 0x10, 0x3C, 0x01, 0x3E, 0x80, 0x44, 0x81, 0x00, 0x00, 0xE7, 0xAA, 0x00, 0xD0, 0xC4, 0xA4, 0x00, 0x00, 0x3C, 0x01, 0x43, 0x48, 0x44, 0x81, 0x10, 0x00, 0xE7, 0xA4, 0x00, 0xCC, 0xC4, 0xA6, 0x00, 0x0C, 0xC4, 0xA8, 0x00, 0x04, 0x3C, 0x01, 0x3F, 0x80, 0x00, 0xA0, 0x88, 0x25, 0x46, 0x06, 0x42, 0x80, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xA8, 0x00, 0xD0, 0x00, 0x80, 0x90, 0x25, 0xE7, 0xAA, 0x00, 0xC8, 0xC4, 0xA4, 0x00, 0x08, 0x46, 0x06, 0x42, 0x81, 0xC7, 0xA6, 0x00, 0xCC, 0xE7, 0xA4, 0x00, 0xC4, 0x46, 0x00, 0x41, 0x02, 0xE7, 0xAA, 0x00, 0x7C, 0xC7, 0xA8, 0x00, 0xC8, 0x46, 0x00, 0x32, 0x82, 0x00, 0x00, 0x98, 0x25, 0x46, 0x00, 0x41, 0x82, 0xE7, 0xA4, 0x00, 0xD0, 0x46, 0x04, 0x10, 0x3C, 0xE7, 0xAA, 0x00, 0xCC, 0xC7, 0xAA, 0x00, 0xC4, 0xE7, 0xA6, 0x00, 0xC8, 0x46, 0x00, 0x52, 0x02, 0xC7, 0xA6, 0x00, 0x7C, 0x46, 0x00, 0x32, 0x82, 0xE7, 0xA8, 0x00, 0xC4, 0x45, 0x00, 0x00, 0x02, 0xE7, 0xAA, 0x00, 0x7C, 0xE7, 0xA2, 0x00, 0xD0, 0x52, 0x40, 0x01, 0xE7, 0x3C, 0x01, 0x40, 0x80, 0x8E, 0x50, 0x00, 0x04, 0xC7, 0xA8, 0x00, 0xC8, 0x8E, 0x52, 0x00, 0x00, 0x86, 0x0E, 0x00, 0x06, 0x44, 0x8E, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x32, 0xA0, 0x46, 0x0A, 0x40, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xD9, 0x00, 0x00, 0x00, 0x00, 0x86, 0x0F, 0x00, 0x08, 0x44, 0x8F, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x21, 0xA0, 0x46, 0x08, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xD1, 0x00, 0x00, 0x00, 0x00, 0xC6, 0x0A, 0x00, 0x1C, 0xC7, 0xA8, 0x00, 0xCC, 0xE7, 0xAA, 0x00, 0x6C, 0xC7, 0xA6, 0x00, 0x6C, 0xC6, 0x04, 0x00, 0x24, 0x46, 0x08, 0x32, 0x82, 0xE7, 0xA4, 0x00, 0x68, 0xC6, 0x04, 0x00, 0x20, 0xC7, 0xA6, 0x00, 0xC8, 0x46, 0x06, 0x22, 0x02, 0xC7, 0xA6, 0x00, 0x68, 0x46, 0x08, 0x51, 0x00, 0xC7, 0xAA, 0x00, 0xC4, 0x46, 0x0A, 0x32, 0x02, 0xC6, 0x0A, 0x00, 0x28, 0x46, 0x08, 0x21, 0x80, 0xC7, 0xA4, 0x00, 0xD0, 0x46, 0x0A, 0x36, 0x80, 0x44, 0x80, 0x40, 0x00, 0x46, 0x1A, 0x20, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xBA, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xD0, 0x3C, 0x3C, 0x18, 0x80, 0x36, 0x45, 0x01, 0x01, 0xB6, 0x00, 0x00, 0x00, 0x00, 0x87, 0x18, 0x11, 0x80, 0x50, 0x18, 0x00, 0x08, 0x86, 0x02, 0x00, 0x00, 0x82, 0x19, 0x00, 0x04, 0x33, 0x28, 0x00, 0x02, 0x53, 0x20, 0x00, 0x1C, 0x86, 0x04, 0x00, 0x0E, 0x10, 0x00, 0x01, 0xAD, 0x00, 0x00, 0x00, 0x00, 0x86, 0x02, 0x00, 0x00, 0x24, 0x01, 0x00, 0x72, 0x10, 0x41, 0x01, 0xA9, 0x24, 0x01, 0x00, 0x7B, 0x14, 0x41, 0x00, 0x13, 0x3C, 0x02, 0x80, 0x36, 0x8C, 0x42, 0x11, 0x60, 0x10, 0x40, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x84, 0x49, 0x00, 0x74, 0x31, 0x2A, 0x00, 0x40, 0x15, 0x40, 0x01, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x10, 0x40, 0x00, 0x0A, 0x3C, 0x0B, 0x80, 0x36, 0x8D, 0x6B, 0x11, 0x58, 0x3C, 0x0C, 0x80, 0x33, 0x55, 0x62, 0x00, 0x07, 0x86, 0x04, 0x00, 0x0E, 0x8D, 0x8C, 0xD9, 0x3C, 0x8D, 0x8D, 0x00, 0x04, 0x31, 0xAE, 0x00, 0x02, 0x15, 0xC0, 0x01, 0x95, 0x00, 0x00, 0x00, 0x00, 0x86, 0x04, 0x00, 0x0E, 0x86, 0x09, 0x00, 0x14, 0x86, 0x02, 0x00, 0x0A, 0x86, 0x0F, 0x00, 0x10, 0x01, 0x24, 0x50, 0x23, 0x44, 0x8A, 0x40, 0x00, 0x86, 0x03, 0x00, 0x0C, 0x86, 0x19, 0x00, 0x12, 0x46, 0x80, 0x41, 0x20, 0x01, 0xE2, 0xC0, 0x23, 0x44, 0x98, 0x30, 0x00, 0x03, 0x23, 0x40, 0x23, 0x44, 0x88, 0x50, 0x00, 0x46, 0x80, 0x37, 0xA0, 0xE7, 0xA4, 0x00, 0xB8, 0x86, 0x0B, 0x00, 0x16, 0x3C, 0x01, 0x3F, 0x80, 0x01, 0x62, 0x60, 0x23, 0x44, 0x8C, 0x30, 0x00, 0x46, 0x80, 0x56, 0x20, 0x46, 0x80, 0x32, 0xA0, 0xE7, 0xAA, 0x00, 0xB4, 0x86, 0x0D, 0x00, 0x18, 0x86, 0x0F, 0x00, 0x1A, 0xE7, 0xA4, 0x00, 0x58, 0x01, 0xA3, 0x70, 0x23, 0x44, 0x8E, 0x40, 0x00, 0x01, 0xE4, 0xC0, 0x23, 0x44, 0x98, 0x30, 0x00, 0x46, 0x80, 0x47, 0x20, 0x44, 0x82, 0x20, 0x00, 0xE7, 0xAA, 0x00, 0x5C, 0x44, 0x83, 0x50, 0x00, 0x46, 0x80, 0x32, 0x20, 0xC7, 0xA6, 0x00, 0xCC, 0x46, 0x80, 0x21, 0x20, 0xE7, 0xA8, 0x00, 0xAC, 0xE7, 0xA8, 0x00, 0x60, 0x44, 0x84, 0x40, 0x00, 0x46, 0x80, 0x52, 0xA0, 0x46, 0x04, 0x31, 0x81, 0xC7, 0xA4, 0x00, 0xC8, 0x46, 0x80, 0x42, 0x20, 0xE7, 0xA6, 0x00, 0xA8, 0xE7, 0xA6, 0x00, 0x64, 0x46, 0x0A, 0x21, 0x01, 0xC7, 0xAA, 0x00, 0xC4, 0x46, 0x08, 0x52, 0x81, 0x46, 0x1E, 0xF2, 0x02, 0xE7, 0xA4, 0x00, 0xA4, 0x46, 0x18, 0xC1, 0x82, 0xE7, 0xAA, 0x00, 0xA0, 0x46, 0x06, 0x42, 0x00, 0xC7, 0xA6, 0x00, 0x58, 0xE7, 0xA4, 0x00, 0x58, 0x46, 0x06, 0x31, 0x02, 0x46, 0x04, 0x44, 0x80, 0xC7, 0xA8, 0x00, 0x5C, 0xE7, 0xAA, 0x00, 0x5C, 0x46, 0x08, 0x41, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0xE2, 0x82, 0x46, 0x0A, 0x21, 0x00, 0xC7, 0xAA, 0x00, 0x60, 0xE7, 0xA6, 0x00, 0x60, 0x46, 0x0A, 0x51, 0x82, 0x46, 0x06, 0x20, 0x00, 0x46, 0x08, 0xF1, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0xC1, 0x82, 0x46, 0x06, 0x21, 0x00, 0xC7, 0xA6, 0x00, 0x60, 0xE7, 0xA8, 0x00, 0x60, 0x46, 0x0A, 0x32, 0x02, 0x46, 0x08, 0x23, 0x80, 0x46, 0x00, 0x91, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x0E, 0x72, 0x02, 0x46, 0x08, 0x21, 0x01, 0x44, 0x81, 0x40, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x04, 0x40, 0x83, 0xC7, 0xA8, 0x00, 0x64, 0xE7, 0xA6, 0x00, 0x64, 0xC7, 0xA6, 0x00, 0x58, 0x46, 0x1E, 0x41, 0x02, 0xE7, 0xAA, 0x00, 0x58, 0x46, 0x18, 0x32, 0x82, 0x46, 0x0A, 0x21, 0x00, 0xC7, 0xAA, 0x00, 0x5C, 0xE7, 0xA8, 0x00, 0x5C, 0xC7, 0xA8, 0x00, 0x64, 0x46, 0x08, 0x52, 0x02, 0x46, 0x08, 0x25, 0x00, 0xC7, 0xA8, 0x00, 0x60, 0xC7, 0xA4, 0x00, 0x5C, 0x46, 0x08, 0x21, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0x32, 0x02, 0x46, 0x08, 0x21, 0x80, 0xC7, 0xA4, 0x00, 0x58, 0x46, 0x04, 0x52, 0x02, 0x46, 0x08, 0x35, 0x80, 0x46, 0x14, 0x02, 0x82, 0x44, 0x80, 0x40, 0x00, 0x46, 0x16, 0x71, 0x02, 0x46, 0x04, 0x51, 0x81, 0x46, 0x02, 0x34, 0x02, 0x46, 0x08, 0x80, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x2B, 0x00, 0x00, 0x00, 0x00, 0x44, 0x81, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x10, 0x50, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x26, 0x44, 0x80, 0x20, 0x00, 0x46, 0x16, 0x91, 0x02, 0x44, 0x80, 0x50, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x14, 0x71, 0x82, 0x46, 0x06, 0x22, 0x01, 0x46, 0x02, 0x40, 0x02, 0x46, 0x0A, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x1C, 0x44, 0x80, 0x20, 0x00, 0x44, 0x81, 0x20, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x00, 0x20, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x16, 0x44, 0x80, 0x20, 0x00, 0x46, 0x00, 0x82, 0x00, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xD0, 0x46, 0x08, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x0F, 0x44, 0x80, 0x20, 0x00, 0x46, 0x1A, 0x50, 0x01, 0xC7, 0xA6, 0x00, 0x6C, 0xC7, 0xA4, 0x00, 0xCC, 0x46, 0x00, 0x32, 0x02, 0xC7, 0xA6, 0x00, 0xC4, 0x46, 0x08, 0x22, 0x80, 0xC7, 0xA4, 0x00, 0x68, 0x46, 0x00, 0x22, 0x02, 0xE7, 0xAA, 0x00, 0xCC, 0x46, 0x08, 0x32, 0x80, 0xE7, 0xAA, 0x00, 0xC4, 0x10, 0x00, 0x00, 0xF2, 0x86, 0x22, 0x00, 0x16, 0x44, 0x80, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xD0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x44, 0x80, 0x30, 0x00, 0xC7, 0xA8, 0x00, 0xA4, 0x46, 0x06, 0xC0, 0x32, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x3C, 0x44, 0x80, 0x50, 0x00, 0x46, 0x18, 0x40, 0x03, 0x44, 0x80, 0x50, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x0A, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x35, 0x44, 0x80, 0x50, 0x00, 0x44, 0x81, 0x20, 0x00, 0xC7, 0xAA, 0x00, 0xB8, 0x46, 0x00, 0x20, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x2F, 0x44, 0x80, 0x50, 0x00, 0x46, 0x00, 0xF1, 0x82, 0xC7, 0xA8, 0x00, 0xA8, 0x46, 0x00, 0x51, 0x02, 0x46, 0x08, 0x35, 0x81, 0xC7, 0xA6, 0x00, 0xA0, 0x46, 0x06, 0x26, 0x01, 0x46, 0x16, 0xB2, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x18, 0xC2, 0x82, 0x0C, 0x0C, 0x8E, 0x94, 0x46, 0x0A, 0x43, 0x00, 0xC7, 0xA4, 0x00, 0x7C, 0x46, 0x00, 0x20, 0x3C, 0x46, 0x04, 0x06, 0x81, 0x45, 0x03, 0x00, 0x1F, 0x44, 0x80, 0x50, 0x00, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xA6, 0x00, 0xCC, 0xC7, 0xAA, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xB4, 0x82, 0x46, 0x12, 0x32, 0x00, 0x46, 0x0C, 0xC5, 0x02, 0xC7, 0xA6, 0x00, 0x7C, 0xE7, 0xA8, 0x00, 0xCC, 0xC4, 0x28, 0x8D, 0x44, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x14, 0x51, 0x00, 0x46, 0x08, 0x32, 0x80, 0xE7, 0xA4, 0x00, 0xC4, 0xE7, 0xAA, 0x00, 0x7C, 0xC6, 0x04, 0x00, 0x1C, 0xC6, 0x08, 0x00, 0x24, 0x46, 0x12, 0x21, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xA2, 0x82, 0xC4, 0x28, 0x8D, 0x48, 0x46, 0x0A, 0x31, 0x00, 0x46, 0x1A, 0x41, 0x82, 0x46, 0x06, 0x20, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0xB7, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0xAC, 0x86, 0x22, 0x00, 0x16, 0x44, 0x80, 0x50, 0x00, 0xC7, 0xA8, 0x00, 0xA4, 0x46, 0x0A, 0xE0, 0x32, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x4A, 0x86, 0x02, 0x00, 0x10, 0x46, 0x1C, 0x40, 0x03, 0x44, 0x80, 0x20, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x04, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x08, 0x86, 0x02, 0x00, 0x10, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xB4, 0x46, 0x00, 0x30, 0x3C, 0xC7, 0xA6, 0x00, 0xAC, 0x45, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x10, 0x00, 0x00, 0x3B, 0x86, 0x07, 0x00, 0x1A, 0x46, 0x00, 0x52, 0x02, 0xC7, 0xA4, 0x00, 0xA8, 0x46, 0x00, 0x32, 0x82, 0x46, 0x04, 0x45, 0x01, 0xC7, 0xA8, 0x00, 0xA0, 0x46, 0x08, 0x55, 0x81, 0x46, 0x14, 0xA1, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x16, 0xB1, 0x82, 0x0C, 0x0C, 0x8E, 0x94, 0x46, 0x06, 0x23, 0x00, 0xC7, 0xA2, 0x00, 0x7C, 0x46, 0x00, 0x10, 0x3C, 0x46, 0x02, 0x06, 0x81, 0x45, 0x02, 0x00, 0x09, 0x46, 0x00, 0xD3, 0x03, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x10, 0x00, 0x00, 0x24, 0x86, 0x07, 0x00, 0x1A, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xAA, 0x00, 0xCC, 0xC7, 0xA4, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xA4, 0x82, 0x46, 0x12, 0x52, 0x00, 0x46, 0x0C, 0xB6, 0x02, 0xC7, 0xAA, 0x00, 0x7C, 0xE7, 0xA8, 0x00, 0xCC, 0xC4, 0x28, 0x8D, 0x4C, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x18, 0x21, 0x80, 0x46, 0x08, 0x51, 0x00, 0xE7, 0xA6, 0x00, 0xC4, 0xE7, 0xA4, 0x00, 0x7C, 0xC6, 0x06, 0x00, 0x1C, 0xC6, 0x08, 0x00, 0x24, 0x46, 0x12, 0x32, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xC1, 0x02, 0xC4, 0x28, 0x8D, 0x50, 0x46, 0x04, 0x51, 0x80, 0x46, 0x1A, 0x42, 0x82, 0x46, 0x0A, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x69, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x5E, 0x86, 0x22, 0x00, 0x16, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x86, 0x07, 0x00, 0x1A, 0x00, 0xA2, 0xC8, 0x23, 0x00, 0xC3, 0x40, 0x23, 0x44, 0x99, 0x20, 0x00, 0x44, 0x88, 0x30, 0x00, 0x00, 0xE4, 0x48, 0x23, 0x44, 0x89, 0x50, 0x00, 0x46, 0x80, 0x22, 0x20, 0x46, 0x80, 0x37, 0x20, 0x44, 0x82, 0x30, 0x00, 0xE7, 0xA8, 0x00, 0xB4, 0xC7, 0xA8, 0x00, 0xCC, 0x46, 0x80, 0x51, 0x20, 0x46, 0x80, 0x32, 0xA0, 0xE7, 0xA4, 0x00, 0xAC, 0xC7, 0xA6, 0x00, 0xC8, 0x46, 0x0A, 0x41, 0x01, 0x44, 0x83, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x42, 0xA0, 0x44, 0x84, 0x40, 0x00, 0xE7, 0xA4, 0x00, 0xA8, 0xC7, 0xA4, 0x00, 0xC4, 0x46, 0x0A, 0x30, 0x81, 0x46, 0x80, 0x41, 0xA0, 0x44, 0x80, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xE0, 0x32, 0x46, 0x06, 0x22, 0x81, 0x45, 0x01, 0x00, 0x43, 0xE7, 0xAA, 0x00, 0xA0, 0x46, 0x1C, 0x10, 0x03, 0x44, 0x80, 0x20, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x04, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xB4, 0x46, 0x00, 0x30, 0x3C, 0xC7, 0xA6, 0x00, 0xAC, 0x45, 0x01, 0x00, 0x36, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0x52, 0x02, 0xC7, 0xA4, 0x00, 0xA8, 0x46, 0x00, 0x32, 0x82, 0x46, 0x04, 0x45, 0x01, 0xC7, 0xA8, 0x00, 0xA0, 0x46, 0x08, 0x55, 0x81, 0x46, 0x14, 0xA1, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x16, 0xB1, 0x82, 0x0C, 0x0C, 0x8E, 0x94, 0x46, 0x06, 0x23, 0x00, 0xC7, 0xA2, 0x00, 0x7C, 0x46, 0x00, 0x10, 0x3C, 0x46, 0x02, 0x06, 0x81, 0x45, 0x01, 0x00, 0x26, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xAA, 0x00, 0xCC, 0xC7, 0xA4, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xA4, 0x82, 0x46, 0x12, 0x52, 0x00, 0x46, 0x0C, 0xB6, 0x02, 0xC7, 0xAA, 0x00, 0x7C, 0xE7, 0xA8, 0x00, 0xCC, 0xC4, 0x28, 0x8D, 0x54, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x18, 0x21, 0x80, 0x46, 0x08, 0x51, 0x00, 0xE7, 0xA6, 0x00, 0xC4, 0xE7, 0xA4, 0x00, 0x7C, 0xC6, 0x06, 0x00, 0x1C, 0xC6, 0x08, 0x00, 0x24, 0x46, 0x12, 0x32, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xC1, 0x02, 0xC4, 0x28, 0x8D, 0x58, 0x46, 0x04, 0x51, 0x80, 0x46, 0x1A, 0x42, 0x82, 0x46, 0x0A, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x86, 0x22, 0x00, 0x16, 0x28, 0x41, 0x00, 0x04, 0x10, 0x20, 0x00, 0x07, 0x26, 0x73, 0x00, 0x01, 0x00, 0x02, 0x50, 0x80, 0x02, 0x2A, 0x58, 0x21, 0xAD, 0x70, 0x00, 0x18, 0x86, 0x2C, 0x00, 0x16, 0x25, 0x8D, 0x00, 0x01, 0xA6, 0x2D, 0x00, 0x16, 0x56, 0x40, 0xFE, 0x1D, 0x8E, 0x50, 0x00, 0x04, 0x3C, 0x01, 0x40, 0x80, 0x44, 0x81, 0x00, 0x00, 0xC7, 0xA4, 0x00, 0xCC, 0xC7, 0xA6, 0x00, 0xC4, 0x02, 0x60, 0x10, 0x25, 0x46, 0x00, 0x22, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0x32, 0x82, 0xE7, 0xA8, 0x00, 0xCC, 0xE7, 0xAA, 0x00, 0xC4, 0xE6, 0x28, 0x00, 0x00, 0xC7, 0xA4, 0x00, 0xC4, 0xE6, 0x24, 0x00, 0x08, 0x8F, 0xBF, 0x00, 0x54, 0x8F, 0xB3, 0x00, 0x50, 0x8F, 0xB2, 0x00, 0x4C, 0x8F, 0xB1, 0x00, 0x48, 0x8F, 0xB0, 0x00, 0x44, 0xD7, 0xBE, 0x00, 0x38, 0xD7, 0xBC, 0x00, 0x30, 0xD7, 0xBA, 0x00, 0x28, 0xD7, 0xB8, 0x00, 0x20, 0xD7, 0xB6, 0x00, 0x18, 0xD7, 0xB4, 0x00, 0x10, 0x03, 0xE0, 0x00, 0x08, 0x27, 0xBD, 0x00, 0xE0
+            0x27, 0xBD, 0xFF, 0x20, 0xAF, 0xBF, 0x00, 0x54, 0xAF, 0xB3, 0x00, 0x50, 0xAF, 0xB2, 0x00, 0x4C, 0xAF, 0xB1, 0x00, 0x48, 0xAF, 0xB0, 0x00, 0x44, 0xF7, 0xBE, 0x00, 0x38, 0xF7, 0xBC, 0x00, 0x30, 0xF7, 0xBA, 0x00, 0x28, 0xF7, 0xB8, 0x00, 0x20, 0xF7, 0xB6, 0x00, 0x18, 0xF7, 0xB4, 0x00, 0x10, 0xC4, 0xAA, 0x00, 0x10, 0x3C, 0x01, 0x3E, 0x80, 0x44, 0x81, 0x00, 0x00, 0xE7, 0xAA, 0x00, 0xD0, 0xC4, 0xA4, 0x00, 0x00, 0x3C, 0x01, 0x43, 0x48, 0x44, 0x81, 0x10, 0x00, 0xE7, 0xA4, 0x00, 0xCC, 0xC4, 0xA6, 0x00, 0x0C, 0xC4, 0xA8, 0x00, 0x04, 0x3C, 0x01, 0x3F, 0x80, 0x00, 0xA0, 0x88, 0x25, 0x46, 0x06, 0x42, 0x80, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xA8, 0x00, 0xD0, 0x00, 0x80, 0x90, 0x25, 0xE7, 0xAA, 0x00, 0xC8, 0xC4, 0xA4, 0x00, 0x08, 0x46, 0x06, 0x42, 0x81, 0xC7, 0xA6, 0x00, 0xCC, 0xE7, 0xA4, 0x00, 0xC4, 0x46, 0x00, 0x41, 0x02, 0xE7, 0xAA, 0x00, 0x7C, 0xC7, 0xA8, 0x00, 0xC8, 0x46, 0x00, 0x32, 0x82, 0x00, 0x00, 0x98, 0x25, 0x46, 0x00, 0x41, 0x82, 0xE7, 0xA4, 0x00, 0xD0, 0x46, 0x04, 0x10, 0x3C, 0xE7, 0xAA, 0x00, 0xCC, 0xC7, 0xAA, 0x00, 0xC4, 0xE7, 0xA6, 0x00, 0xC8, 0x46, 0x00, 0x52, 0x02, 0xC7, 0xA6, 0x00, 0x7C, 0x46, 0x00, 0x32, 0x82, 0xE7, 0xA8, 0x00, 0xC4, 0x45, 0x00, 0x00, 0x02, 0xE7, 0xAA, 0x00, 0x7C, 0xE7, 0xA2, 0x00, 0xD0, 0x52, 0x40, 0x01, 0xF2, 0x3C, 0x01, 0x40, 0x80, 0x8E, 0x50, 0x00, 0x04, 0xC7, 0xA8, 0x00, 0xC8, 0x8E, 0x52, 0x00, 0x00, 0x86, 0x0E, 0x00, 0x06, 0x44, 0x8E, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x32, 0xA0, 0x46, 0x0A, 0x40, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xE4, 0x00, 0x00, 0x00, 0x00, 0x86, 0x0F, 0x00, 0x08, 0x44, 0x8F, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x21, 0xA0, 0x46, 0x08, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xDC, 0x00, 0x00, 0x00, 0x00, 0xC6, 0x0A, 0x00, 0x1C, 0xC7, 0xA8, 0x00, 0xCC, 0xE7, 0xAA, 0x00, 0x6C, 0xC7, 0xA6, 0x00, 0x6C, 0xC6, 0x04, 0x00, 0x24, 0x46, 0x08, 0x32, 0x82, 0xE7, 0xA4, 0x00, 0x68, 0xC6, 0x04, 0x00, 0x20, 0xC7, 0xA6, 0x00, 0xC8, 0x46, 0x06, 0x22, 0x02, 0xC7, 0xA6, 0x00, 0x68, 0x46, 0x08, 0x51, 0x00, 0xC7, 0xAA, 0x00, 0xC4, 0x46, 0x0A, 0x32, 0x02, 0xC6, 0x0A, 0x00, 0x28, 0x46, 0x08, 0x21, 0x80, 0xC7, 0xA4, 0x00, 0xD0, 0x46, 0x0A, 0x36, 0x80, 0x44, 0x80, 0x40, 0x00, 0x46, 0x1A, 0x20, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xC5, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xD0, 0x3C, 0x3C, 0x18, 0x80, 0x36, 0x45, 0x01, 0x01, 0xC1, 0x00, 0x00, 0x00, 0x00, 0x87, 0x18, 0x11, 0x80, 0x50, 0x18, 0x00, 0x08, 0x86, 0x02, 0x00, 0x00, 0x82, 0x19, 0x00, 0x04, 0x33, 0x28, 0x00, 0x02, 0x53, 0x20, 0x00, 0x1C, 0x86, 0x04, 0x00, 0x0E, 0x10, 0x00, 0x01, 0xB8, 0x00, 0x00, 0x00, 0x00, 0x86, 0x02, 0x00, 0x00, 0x24, 0x01, 0x00, 0x72, 0x10, 0x41, 0x01, 0xB4, 0x24, 0x01, 0x00, 0x7B, 0x14, 0x41, 0x00, 0x13, 0x3C, 0x02, 0x80, 0x36, 0x8C, 0x42, 0x11, 0x60, 0x10, 0x40, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x84, 0x49, 0x00, 0x74, 0x31, 0x2A, 0x00, 0x40, 0x15, 0x40, 0x01, 0xAB, 0x00, 0x00, 0x00, 0x00, 0x10, 0x40, 0x00, 0x0A, 0x3C, 0x0B, 0x80, 0x36, 0x8D, 0x6B, 0x11, 0x58, 0x3C, 0x0C, 0x80, 0x33, 0x55, 0x62, 0x00, 0x07, 0x86, 0x04, 0x00, 0x0E, 0x8D, 0x8C, 0xD9, 0x3C, 0x8D, 0x8D, 0x00, 0x04, 0x31, 0xAE, 0x00, 0x02, 0x15, 0xC0, 0x01, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x86, 0x04, 0x00, 0x0E, 0x86, 0x09, 0x00, 0x14, 0x86, 0x02, 0x00, 0x0A, 0x86, 0x0F, 0x00, 0x10, 0x01, 0x24, 0x50, 0x23, 0x44, 0x8A, 0x40, 0x00, 0x86, 0x03, 0x00, 0x0C, 0x86, 0x19, 0x00, 0x12, 0x46, 0x80, 0x41, 0x20, 0x01, 0xE2, 0xC0, 0x23, 0x44, 0x98, 0x30, 0x00, 0x03, 0x23, 0x40, 0x23, 0x44, 0x88, 0x50, 0x00, 0x46, 0x80, 0x37, 0xA0, 0xE7, 0xA4, 0x00, 0xB8, 0x86, 0x0B, 0x00, 0x16, 0x3C, 0x01, 0x3F, 0x80, 0x01, 0x62, 0x60, 0x23, 0x44, 0x8C, 0x30, 0x00, 0x46, 0x80, 0x56, 0x20, 0x46, 0x80, 0x32, 0xA0, 0xE7, 0xAA, 0x00, 0xB4, 0x86, 0x0D, 0x00, 0x18, 0x86, 0x0F, 0x00, 0x1A, 0xE7, 0xA4, 0x00, 0x58, 0x01, 0xA3, 0x70, 0x23, 0x44, 0x8E, 0x40, 0x00, 0x01, 0xE4, 0xC0, 0x23, 0x44, 0x98, 0x30, 0x00, 0x46, 0x80, 0x47, 0x20, 0x44, 0x82, 0x20, 0x00, 0xE7, 0xAA, 0x00, 0x5C, 0x44, 0x83, 0x50, 0x00, 0x46, 0x80, 0x32, 0x20, 0xC7, 0xA6, 0x00, 0xCC, 0x46, 0x80, 0x21, 0x20, 0xE7, 0xA8, 0x00, 0xAC, 0xE7, 0xA8, 0x00, 0x60, 0x44, 0x84, 0x40, 0x00, 0x46, 0x80, 0x52, 0xA0, 0x46, 0x04, 0x31, 0x81, 0xC7, 0xA4, 0x00, 0xC8, 0x46, 0x80, 0x42, 0x20, 0xE7, 0xA6, 0x00, 0xA8, 0xE7, 0xA6, 0x00, 0x64, 0x46, 0x0A, 0x21, 0x01, 0xC7, 0xAA, 0x00, 0xC4, 0x46, 0x08, 0x52, 0x81, 0x46, 0x1E, 0xF2, 0x02, 0xE7, 0xA4, 0x00, 0xA4, 0x46, 0x18, 0xC1, 0x82, 0xE7, 0xAA, 0x00, 0xA0, 0x46, 0x06, 0x42, 0x00, 0xC7, 0xA6, 0x00, 0x58, 0xE7, 0xA4, 0x00, 0x58, 0x46, 0x06, 0x31, 0x02, 0x46, 0x04, 0x44, 0x80, 0xC7, 0xA8, 0x00, 0x5C, 0xE7, 0xAA, 0x00, 0x5C, 0x46, 0x08, 0x41, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0xE2, 0x82, 0x46, 0x0A, 0x21, 0x00, 0xC7, 0xAA, 0x00, 0x60, 0xE7, 0xA6, 0x00, 0x60, 0x46, 0x0A, 0x51, 0x82, 0x46, 0x06, 0x20, 0x00, 0x46, 0x08, 0xF1, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0xC1, 0x82, 0x46, 0x06, 0x21, 0x00, 0xC7, 0xA6, 0x00, 0x60, 0xE7, 0xA8, 0x00, 0x60, 0x46, 0x0A, 0x32, 0x02, 0x46, 0x08, 0x23, 0x80, 0x46, 0x00, 0x91, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x0E, 0x72, 0x02, 0x46, 0x08, 0x21, 0x01, 0x44, 0x81, 0x40, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x04, 0x40, 0x83, 0xC7, 0xA8, 0x00, 0x64, 0xE7, 0xA6, 0x00, 0x64, 0xC7, 0xA6, 0x00, 0x58, 0x46, 0x1E, 0x41, 0x02, 0xE7, 0xAA, 0x00, 0x58, 0x46, 0x18, 0x32, 0x82, 0x46, 0x0A, 0x21, 0x00, 0xC7, 0xAA, 0x00, 0x5C, 0xE7, 0xA8, 0x00, 0x5C, 0xC7, 0xA8, 0x00, 0x64, 0x46, 0x08, 0x52, 0x02, 0x46, 0x08, 0x25, 0x00, 0xC7, 0xA8, 0x00, 0x60, 0xC7, 0xA4, 0x00, 0x5C, 0x46, 0x08, 0x21, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0x32, 0x02, 0x46, 0x08, 0x21, 0x80, 0xC7, 0xA4, 0x00, 0x58, 0x46, 0x04, 0x52, 0x02, 0x46, 0x08, 0x35, 0x80, 0x46, 0x14, 0x02, 0x82, 0x44, 0x80, 0x40, 0x00, 0x46, 0x16, 0x71, 0x02, 0x46, 0x04, 0x51, 0x81, 0x46, 0x02, 0x34, 0x02, 0x46, 0x08, 0x80, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x2B, 0x00, 0x00, 0x00, 0x00, 0x44, 0x81, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x10, 0x50, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x26, 0x44, 0x80, 0x20, 0x00, 0x46, 0x16, 0x91, 0x02, 0x44, 0x80, 0x50, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x14, 0x71, 0x82, 0x46, 0x06, 0x22, 0x01, 0x46, 0x02, 0x40, 0x02, 0x46, 0x0A, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x1C, 0x44, 0x80, 0x20, 0x00, 0x44, 0x81, 0x20, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x00, 0x20, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x16, 0x44, 0x80, 0x20, 0x00, 0x46, 0x00, 0x82, 0x00, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xD0, 0x46, 0x08, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x0F, 0x44, 0x80, 0x20, 0x00, 0x46, 0x1A, 0x50, 0x01, 0xC7, 0xA6, 0x00, 0x6C, 0xC7, 0xA4, 0x00, 0xCC, 0x46, 0x00, 0x32, 0x02, 0xC7, 0xA6, 0x00, 0xC4, 0x46, 0x08, 0x22, 0x80, 0xC7, 0xA4, 0x00, 0x68, 0x46, 0x00, 0x22, 0x02, 0xE7, 0xAA, 0x00, 0xCC, 0x46, 0x08, 0x32, 0x80, 0xE7, 0xAA, 0x00, 0xC4, 0x10, 0x00, 0x00, 0xFD, 0x86, 0x22, 0x00, 0x16, 0x44, 0x80, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xD0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0x00, 0xC7, 0xAE, 0x00, 0x7C, 0x46, 0x0E, 0x74, 0x02, 0x46, 0x0E, 0x84, 0x00, 0x44, 0x80, 0x30, 0x00, 0xC7, 0xA8, 0x00, 0xA4, 0x46, 0x06, 0xC0, 0x32, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x3F, 0x44, 0x80, 0x50, 0x00, 0x46, 0x18, 0x40, 0x03, 0x44, 0x80, 0x50, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x0A, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x38, 0x44, 0x80, 0x50, 0x00, 0x44, 0x81, 0x20, 0x00, 0xC7, 0xAA, 0x00, 0xB8, 0x46, 0x00, 0x20, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x32, 0x44, 0x80, 0x50, 0x00, 0x46, 0x00, 0xF1, 0x82, 0xC7, 0xA8, 0x00, 0xA8, 0x46, 0x00, 0x51, 0x02, 0x46, 0x08, 0x35, 0x81, 0xC7, 0xA6, 0x00, 0xA0, 0x46, 0x06, 0x26, 0x01, 0x46, 0x16, 0xB2, 0x02, 0x46, 0x18, 0xC2, 0x82, 0x46, 0x0A, 0x43, 0x00, 0x46, 0x0C, 0x80, 0x3C, 0x45, 0x03, 0x00, 0x26, 0x44, 0x80, 0x50, 0x00, 0x0C, 0x0C, 0x8E, 0x94, 0x00, 0x00, 0x00, 0x00, 0xC7, 0xA4, 0x00, 0x7C, 0x46, 0x00, 0x20, 0x3C, 0x46, 0x04, 0x06, 0x81, 0x45, 0x03, 0x00, 0x1F, 0x44, 0x80, 0x50, 0x00, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xA6, 0x00, 0xCC, 0xC7, 0xAA, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xB4, 0x82, 0x46, 0x12, 0x32, 0x00, 0x46, 0x0C, 0xC5, 0x02, 0xC7, 0xA6, 0x00, 0x7C, 0xE7, 0xA8, 0x00, 0xCC, 0xC4, 0x28, 0x8D, 0x44, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x14, 0x51, 0x00, 0x46, 0x08, 0x32, 0x80, 0xE7, 0xA4, 0x00, 0xC4, 0xE7, 0xAA, 0x00, 0x7C, 0xC6, 0x04, 0x00, 0x1C, 0xC6, 0x08, 0x00, 0x24, 0x46, 0x12, 0x21, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xA2, 0x82, 0xC4, 0x28, 0x8D, 0x48, 0x46, 0x0A, 0x31, 0x00, 0x46, 0x1A, 0x41, 0x82, 0x46, 0x06, 0x20, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0xBD, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0xB2, 0x86, 0x22, 0x00, 0x16, 0x44, 0x80, 0x50, 0x00, 0xC7, 0xA8, 0x00, 0xA4, 0x46, 0x0A, 0xE0, 0x32, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x4D, 0x86, 0x02, 0x00, 0x10, 0x46, 0x1C, 0x40, 0x03, 0x44, 0x80, 0x20, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x04, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x08, 0x86, 0x02, 0x00, 0x10, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xB4, 0x46, 0x00, 0x30, 0x3C, 0xC7, 0xA6, 0x00, 0xAC, 0x45, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x10, 0x00, 0x00, 0x3E, 0x86, 0x07, 0x00, 0x1A, 0x46, 0x00, 0x52, 0x02, 0xC7, 0xA4, 0x00, 0xA8, 0x46, 0x00, 0x32, 0x82, 0x46, 0x04, 0x45, 0x01, 0xC7, 0xA8, 0x00, 0xA0, 0x46, 0x08, 0x55, 0x81, 0x46, 0x14, 0xA1, 0x02, 0x46, 0x16, 0xB1, 0x82, 0x46, 0x06, 0x23, 0x00, 0x46, 0x0C, 0x80, 0x3C, 0x45, 0x03, 0x00, 0x2D, 0x86, 0x02, 0x00, 0x10, 0x0C, 0x0C, 0x8E, 0x94, 0x00, 0x00, 0x00, 0x00, 0xC7, 0xA2, 0x00, 0x7C, 0x46, 0x00, 0x10, 0x3C, 0x46, 0x02, 0x06, 0x81, 0x45, 0x02, 0x00, 0x09, 0x46, 0x00, 0xD3, 0x03, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x10, 0x00, 0x00, 0x24, 0x86, 0x07, 0x00, 0x1A, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xAA, 0x00, 0xCC, 0xC7, 0xA4, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xA4, 0x82, 0x46, 0x12, 0x52, 0x00, 0x46, 0x0C, 0xB6, 0x02, 0xC7, 0xAA, 0x00, 0x7C, 0xE7, 0xA8, 0x00, 0xCC, 0xC4, 0x28, 0x8D, 0x4C, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x18, 0x21, 0x80, 0x46, 0x08, 0x51, 0x00, 0xE7, 0xA6, 0x00, 0xC4, 0xE7, 0xA4, 0x00, 0x7C, 0xC6, 0x06, 0x00, 0x1C, 0xC6, 0x08, 0x00, 0x24, 0x46, 0x12, 0x32, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xC1, 0x02, 0xC4, 0x28, 0x8D, 0x50, 0x46, 0x04, 0x51, 0x80, 0x46, 0x1A, 0x42, 0x82, 0x46, 0x0A, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x6C, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x61, 0x86, 0x22, 0x00, 0x16, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x86, 0x07, 0x00, 0x1A, 0x00, 0xA2, 0xC8, 0x23, 0x00, 0xC3, 0x40, 0x23, 0x44, 0x99, 0x20, 0x00, 0x44, 0x88, 0x30, 0x00, 0x00, 0xE4, 0x48, 0x23, 0x44, 0x89, 0x50, 0x00, 0x46, 0x80, 0x22, 0x20, 0x46, 0x80, 0x37, 0x20, 0x44, 0x82, 0x30, 0x00, 0xE7, 0xA8, 0x00, 0xB4, 0xC7, 0xA8, 0x00, 0xCC, 0x46, 0x80, 0x51, 0x20, 0x46, 0x80, 0x32, 0xA0, 0xE7, 0xA4, 0x00, 0xAC, 0xC7, 0xA6, 0x00, 0xC8, 0x46, 0x0A, 0x41, 0x01, 0x44, 0x83, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x42, 0xA0, 0x44, 0x84, 0x40, 0x00, 0xE7, 0xA4, 0x00, 0xA8, 0xC7, 0xA4, 0x00, 0xC4, 0x46, 0x0A, 0x30, 0x81, 0x46, 0x80, 0x41, 0xA0, 0x44, 0x80, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xE0, 0x32, 0x46, 0x06, 0x22, 0x81, 0x45, 0x01, 0x00, 0x46, 0xE7, 0xAA, 0x00, 0xA0, 0x46, 0x1C, 0x10, 0x03, 0x44, 0x80, 0x20, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x04, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xB4, 0x46, 0x00, 0x30, 0x3C, 0xC7, 0xA6, 0x00, 0xAC, 0x45, 0x01, 0x00, 0x39, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0x52, 0x02, 0xC7, 0xA4, 0x00, 0xA8, 0x46, 0x00, 0x32, 0x82, 0x46, 0x04, 0x45, 0x01, 0xC7, 0xA8, 0x00, 0xA0, 0x46, 0x08, 0x55, 0x81, 0x46, 0x14, 0xA1, 0x02, 0x46, 0x16, 0xB1, 0x82, 0x46, 0x06, 0x23, 0x00, 0x46, 0x0C, 0x80, 0x3C, 0x45, 0x01, 0x00, 0x2D, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x8E, 0x94, 0x00, 0x00, 0x00, 0x00, 0xC7, 0xA2, 0x00, 0x7C, 0x46, 0x00, 0x10, 0x3C, 0x46, 0x02, 0x06, 0x81, 0x45, 0x01, 0x00, 0x26, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xAA, 0x00, 0xCC, 0xC7, 0xA4, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xA4, 0x82, 0x46, 0x12, 0x52, 0x00, 0x46, 0x0C, 0xB6, 0x02, 0xC7, 0xAA, 0x00, 0x7C, 0xE7, 0xA8, 0x00, 0xCC, 0xC4, 0x28, 0x8D, 0x54, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x18, 0x21, 0x80, 0x46, 0x08, 0x51, 0x00, 0xE7, 0xA6, 0x00, 0xC4, 0xE7, 0xA4, 0x00, 0x7C, 0xC6, 0x06, 0x00, 0x1C, 0xC6, 0x08, 0x00, 0x24, 0x46, 0x12, 0x32, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xC1, 0x02, 0xC4, 0x28, 0x8D, 0x58, 0x46, 0x04, 0x51, 0x80, 0x46, 0x1A, 0x42, 0x82, 0x46, 0x0A, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x86, 0x22, 0x00, 0x16, 0x28, 0x41, 0x00, 0x04, 0x10, 0x20, 0x00, 0x07, 0x26, 0x73, 0x00, 0x01, 0x00, 0x02, 0x50, 0x80, 0x02, 0x2A, 0x58, 0x21, 0xAD, 0x70, 0x00, 0x18, 0x86, 0x2C, 0x00, 0x16, 0x25, 0x8D, 0x00, 0x01, 0xA6, 0x2D, 0x00, 0x16, 0x56, 0x40, 0xFE, 0x12, 0x8E, 0x50, 0x00, 0x04, 0x3C, 0x01, 0x40, 0x80, 0x44, 0x81, 0x00, 0x00, 0xC7, 0xA4, 0x00, 0xCC, 0xC7, 0xA6, 0x00, 0xC4, 0x02, 0x60, 0x10, 0x25, 0x46, 0x00, 0x22, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0x32, 0x82, 0xE7, 0xA8, 0x00, 0xCC, 0xE7, 0xAA, 0x00, 0xC4, 0xE6, 0x28, 0x00, 0x00, 0xC7, 0xA4, 0x00, 0xC4, 0xE6, 0x24, 0x00, 0x08, 0x8F, 0xBF, 0x00, 0x54, 0x8F, 0xB3, 0x00, 0x50, 0x8F, 0xB2, 0x00, 0x4C, 0x8F, 0xB1, 0x00, 0x48, 0x8F, 0xB0, 0x00, 0x44, 0xD7, 0xBE, 0x00, 0x38, 0xD7, 0xBC, 0x00, 0x30, 0xD7, 0xBA, 0x00, 0x28, 0xD7, 0xB8, 0x00, 0x20, 0xD7, 0xB6, 0x00, 0x18, 0xD7, 0xB4, 0x00, 0x10, 0x03, 0xE0, 0x00, 0x08, 0x27, 0xBD, 0x00, 0xE0
         };
 
         static byte[] find_wall_collisions_from_list_regular_bounds = new byte[]
         {
-            0x27, 0xBD, 0xFF, 0x20, 0xAF, 0xBF, 0x00, 0x54, 0xAF, 0xB3, 0x00, 0x50, 0xAF, 0xB2, 0x00, 0x4C, 0xAF, 0xB1, 0x00, 0x48, 0xAF, 0xB0, 0x00, 0x44, 0xF7, 0xBE, 0x00, 0x38, 0xF7, 0xBC, 0x00, 0x30, 0xF7, 0xBA, 0x00, 0x28, 0xF7, 0xB8, 0x00, 0x20, 0xF7, 0xB6, 0x00, 0x18, 0xF7, 0xB4, 0x00, 0x10, 0xC4, 0xAA, 0x00, 0x10, 0x3C, 0x01, 0x43, 0x48, 0x44, 0x81, 0x00, 0x00, 0xE7, 0xAA, 0x00, 0xD0, 0xC4, 0xA4, 0x00, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x00, 0xA0, 0x88, 0x25, 0xE7, 0xA4, 0x00, 0xCC, 0xC4, 0xA6, 0x00, 0x0C, 0xC4, 0xA8, 0x00, 0x04, 0x00, 0x80, 0x90, 0x25, 0x00, 0x00, 0x98, 0x25, 0x46, 0x06, 0x42, 0x80, 0xC7, 0xA8, 0x00, 0xD0, 0x44, 0x81, 0x30, 0x00, 0x46, 0x08, 0x00, 0x3C, 0xE7, 0xAA, 0x00, 0xC8, 0x46, 0x06, 0x42, 0x81, 0xC4, 0xA4, 0x00, 0x08, 0xE7, 0xAA, 0x00, 0x7C, 0x45, 0x00, 0x00, 0x02, 0xE7, 0xA4, 0x00, 0xC4, 0xE7, 0xA0, 0x00, 0xD0, 0x52, 0x40, 0x01, 0xE7, 0xC7, 0xA8, 0x00, 0xCC, 0x8E, 0x50, 0x00, 0x04, 0xC7, 0xA4, 0x00, 0xC8, 0x8E, 0x52, 0x00, 0x00, 0x86, 0x0E, 0x00, 0x06, 0x44, 0x8E, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x32, 0xA0, 0x46, 0x0A, 0x20, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xD9, 0x00, 0x00, 0x00, 0x00, 0x86, 0x0F, 0x00, 0x08, 0x44, 0x8F, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x41, 0xA0, 0x46, 0x04, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xD1, 0x00, 0x00, 0x00, 0x00, 0xC6, 0x0A, 0x00, 0x1C, 0xC7, 0xA4, 0x00, 0xCC, 0xE7, 0xAA, 0x00, 0x70, 0xC7, 0xA6, 0x00, 0x70, 0xC6, 0x08, 0x00, 0x24, 0x46, 0x04, 0x32, 0x82, 0xE7, 0xA8, 0x00, 0x6C, 0xC6, 0x08, 0x00, 0x20, 0xC7, 0xA6, 0x00, 0xC8, 0x46, 0x06, 0x41, 0x02, 0xC7, 0xA6, 0x00, 0x6C, 0x46, 0x04, 0x52, 0x00, 0xC7, 0xAA, 0x00, 0xC4, 0x46, 0x0A, 0x31, 0x02, 0xC6, 0x0A, 0x00, 0x28, 0x46, 0x04, 0x41, 0x80, 0xC7, 0xA8, 0x00, 0xD0, 0x46, 0x0A, 0x36, 0x80, 0x44, 0x80, 0x20, 0x00, 0x46, 0x1A, 0x40, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xBA, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xD0, 0x3C, 0x3C, 0x18, 0x80, 0x36, 0x45, 0x01, 0x01, 0xB6, 0x00, 0x00, 0x00, 0x00, 0x87, 0x18, 0x11, 0x80, 0x53, 0x00, 0x00, 0x08, 0x86, 0x02, 0x00, 0x00, 0x82, 0x19, 0x00, 0x04, 0x33, 0x28, 0x00, 0x02, 0x51, 0x00, 0x00, 0x1C, 0x86, 0x04, 0x00, 0x0E, 0x10, 0x00, 0x01, 0xAD, 0x00, 0x00, 0x00, 0x00, 0x86, 0x02, 0x00, 0x00, 0x24, 0x01, 0x00, 0x72, 0x10, 0x41, 0x01, 0xA9, 0x24, 0x01, 0x00, 0x7B, 0x14, 0x41, 0x00, 0x13, 0x3C, 0x02, 0x80, 0x36, 0x8C, 0x42, 0x11, 0x60, 0x10, 0x40, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x84, 0x49, 0x00, 0x74, 0x31, 0x2A, 0x00, 0x40, 0x15, 0x40, 0x01, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x10, 0x40, 0x00, 0x0A, 0x3C, 0x0B, 0x80, 0x36, 0x8D, 0x6B, 0x11, 0x58, 0x3C, 0x0C, 0x80, 0x33, 0x55, 0x62, 0x00, 0x07, 0x86, 0x04, 0x00, 0x0E, 0x8D, 0x8C, 0xD9, 0x3C, 0x8D, 0x8D, 0x00, 0x04, 0x31, 0xAE, 0x00, 0x02, 0x15, 0xC0, 0x01, 0x95, 0x00, 0x00, 0x00, 0x00, 0x86, 0x04, 0x00, 0x0E, 0x86, 0x09, 0x00, 0x14, 0x86, 0x02, 0x00, 0x0A, 0x86, 0x0F, 0x00, 0x10, 0x01, 0x24, 0x50, 0x23, 0x44, 0x8A, 0x20, 0x00, 0x86, 0x03, 0x00, 0x0C, 0x86, 0x19, 0x00, 0x12, 0x46, 0x80, 0x22, 0x20, 0x01, 0xE2, 0xC0, 0x23, 0x44, 0x98, 0x30, 0x00, 0x03, 0x23, 0x40, 0x23, 0x44, 0x88, 0x50, 0x00, 0x46, 0x80, 0x37, 0xA0, 0xE7, 0xA8, 0x00, 0xB8, 0x86, 0x0B, 0x00, 0x16, 0x3C, 0x01, 0x3F, 0x80, 0x01, 0x62, 0x60, 0x23, 0x44, 0x8C, 0x30, 0x00, 0x46, 0x80, 0x56, 0x20, 0x46, 0x80, 0x32, 0xA0, 0xE7, 0xAA, 0x00, 0xB4, 0x86, 0x0D, 0x00, 0x18, 0x86, 0x0F, 0x00, 0x1A, 0xE7, 0xA8, 0x00, 0x58, 0x01, 0xA3, 0x70, 0x23, 0x44, 0x8E, 0x20, 0x00, 0x01, 0xE4, 0xC0, 0x23, 0x44, 0x98, 0x30, 0x00, 0x46, 0x80, 0x27, 0x20, 0x44, 0x82, 0x40, 0x00, 0xE7, 0xAA, 0x00, 0x5C, 0x44, 0x83, 0x50, 0x00, 0x46, 0x80, 0x31, 0x20, 0xC7, 0xA6, 0x00, 0xCC, 0x46, 0x80, 0x42, 0x20, 0xE7, 0xA4, 0x00, 0xAC, 0xE7, 0xA4, 0x00, 0x60, 0x44, 0x84, 0x20, 0x00, 0x46, 0x80, 0x52, 0xA0, 0x46, 0x08, 0x31, 0x81, 0xC7, 0xA8, 0x00, 0xC8, 0x46, 0x80, 0x21, 0x20, 0xE7, 0xA6, 0x00, 0xA8, 0xE7, 0xA6, 0x00, 0x64, 0x46, 0x0A, 0x42, 0x01, 0xC7, 0xAA, 0x00, 0xC4, 0x46, 0x04, 0x52, 0x81, 0x46, 0x1E, 0xF1, 0x02, 0xE7, 0xA8, 0x00, 0xA4, 0x46, 0x18, 0xC1, 0x82, 0xE7, 0xAA, 0x00, 0xA0, 0x46, 0x06, 0x21, 0x00, 0xC7, 0xA6, 0x00, 0x58, 0xE7, 0xA8, 0x00, 0x58, 0x46, 0x06, 0x32, 0x02, 0x46, 0x08, 0x24, 0x80, 0xC7, 0xA4, 0x00, 0x5C, 0xE7, 0xAA, 0x00, 0x5C, 0x46, 0x04, 0x22, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0xE2, 0x82, 0x46, 0x0A, 0x42, 0x00, 0xC7, 0xAA, 0x00, 0x60, 0xE7, 0xA6, 0x00, 0x60, 0x46, 0x0A, 0x51, 0x82, 0x46, 0x06, 0x40, 0x00, 0x46, 0x04, 0xF2, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0xC1, 0x82, 0x46, 0x06, 0x42, 0x00, 0xC7, 0xA6, 0x00, 0x60, 0xE7, 0xA4, 0x00, 0x60, 0x46, 0x0A, 0x31, 0x02, 0x46, 0x04, 0x43, 0x80, 0x46, 0x00, 0x92, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x0E, 0x71, 0x02, 0x46, 0x04, 0x42, 0x01, 0x44, 0x81, 0x20, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x08, 0x20, 0x83, 0xC7, 0xA4, 0x00, 0x64, 0xE7, 0xA6, 0x00, 0x64, 0xC7, 0xA6, 0x00, 0x58, 0x46, 0x1E, 0x22, 0x02, 0xE7, 0xAA, 0x00, 0x58, 0x46, 0x18, 0x32, 0x82, 0x46, 0x0A, 0x42, 0x00, 0xC7, 0xAA, 0x00, 0x5C, 0xE7, 0xA4, 0x00, 0x5C, 0xC7, 0xA4, 0x00, 0x64, 0x46, 0x04, 0x51, 0x02, 0x46, 0x04, 0x45, 0x00, 0xC7, 0xA4, 0x00, 0x60, 0xC7, 0xA8, 0x00, 0x5C, 0x46, 0x04, 0x42, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0x31, 0x02, 0x46, 0x04, 0x41, 0x80, 0xC7, 0xA8, 0x00, 0x58, 0x46, 0x08, 0x51, 0x02, 0x46, 0x04, 0x35, 0x80, 0x46, 0x14, 0x02, 0x82, 0x44, 0x80, 0x20, 0x00, 0x46, 0x16, 0x72, 0x02, 0x46, 0x08, 0x51, 0x81, 0x46, 0x02, 0x34, 0x02, 0x46, 0x04, 0x80, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x2B, 0x00, 0x00, 0x00, 0x00, 0x44, 0x81, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x10, 0x50, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x26, 0x44, 0x80, 0x40, 0x00, 0x46, 0x16, 0x92, 0x02, 0x44, 0x80, 0x50, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x14, 0x71, 0x82, 0x46, 0x06, 0x41, 0x01, 0x46, 0x02, 0x20, 0x02, 0x46, 0x0A, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x1C, 0x44, 0x80, 0x40, 0x00, 0x44, 0x81, 0x40, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x00, 0x40, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x16, 0x44, 0x80, 0x40, 0x00, 0x46, 0x00, 0x81, 0x00, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xD0, 0x46, 0x04, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x0F, 0x44, 0x80, 0x40, 0x00, 0x46, 0x1A, 0x50, 0x01, 0xC7, 0xA6, 0x00, 0x70, 0xC7, 0xA8, 0x00, 0xCC, 0x46, 0x00, 0x31, 0x02, 0xC7, 0xA6, 0x00, 0xC4, 0x46, 0x04, 0x42, 0x80, 0xC7, 0xA8, 0x00, 0x6C, 0x46, 0x00, 0x41, 0x02, 0xE7, 0xAA, 0x00, 0xCC, 0x46, 0x04, 0x32, 0x80, 0xE7, 0xAA, 0x00, 0xC4, 0x10, 0x00, 0x00, 0xF2, 0x86, 0x22, 0x00, 0x16, 0x44, 0x80, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xD0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x44, 0x80, 0x30, 0x00, 0xC7, 0xA4, 0x00, 0xA4, 0x46, 0x06, 0xC0, 0x32, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x3C, 0x44, 0x80, 0x50, 0x00, 0x46, 0x18, 0x20, 0x03, 0x44, 0x80, 0x50, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x0A, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x35, 0x44, 0x80, 0x50, 0x00, 0x44, 0x81, 0x40, 0x00, 0xC7, 0xAA, 0x00, 0xB8, 0x46, 0x00, 0x40, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x2F, 0x44, 0x80, 0x50, 0x00, 0x46, 0x00, 0xF1, 0x82, 0xC7, 0xA4, 0x00, 0xA8, 0x46, 0x00, 0x52, 0x02, 0x46, 0x04, 0x35, 0x81, 0xC7, 0xA6, 0x00, 0xA0, 0x46, 0x06, 0x46, 0x01, 0x46, 0x16, 0xB1, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x18, 0xC2, 0x82, 0x0C, 0x0C, 0x8E, 0x94, 0x46, 0x0A, 0x23, 0x00, 0xC7, 0xA8, 0x00, 0x7C, 0x46, 0x00, 0x40, 0x3C, 0x46, 0x08, 0x06, 0x81, 0x45, 0x03, 0x00, 0x1F, 0x44, 0x80, 0x50, 0x00, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xA6, 0x00, 0xCC, 0xC7, 0xAA, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xB4, 0x82, 0x46, 0x12, 0x31, 0x00, 0x46, 0x0C, 0xC5, 0x02, 0xC7, 0xA6, 0x00, 0x7C, 0xE7, 0xA4, 0x00, 0xCC, 0xC4, 0x24, 0x8C, 0xE4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x14, 0x52, 0x00, 0x46, 0x04, 0x32, 0x80, 0xE7, 0xA8, 0x00, 0xC4, 0xE7, 0xAA, 0x00, 0x7C, 0xC6, 0x08, 0x00, 0x1C, 0xC6, 0x04, 0x00, 0x24, 0x46, 0x12, 0x41, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xA2, 0x82, 0xC4, 0x24, 0x8C, 0xE8, 0x46, 0x0A, 0x32, 0x00, 0x46, 0x1A, 0x21, 0x82, 0x46, 0x06, 0x40, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0xB7, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0xAC, 0x86, 0x22, 0x00, 0x16, 0x44, 0x80, 0x50, 0x00, 0xC7, 0xA4, 0x00, 0xA4, 0x46, 0x0A, 0xE0, 0x32, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x4A, 0x86, 0x02, 0x00, 0x10, 0x46, 0x1C, 0x20, 0x03, 0x44, 0x80, 0x40, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x08, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x08, 0x86, 0x02, 0x00, 0x10, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xB4, 0x46, 0x00, 0x30, 0x3C, 0xC7, 0xA6, 0x00, 0xAC, 0x45, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x10, 0x00, 0x00, 0x3B, 0x86, 0x07, 0x00, 0x1A, 0x46, 0x00, 0x51, 0x02, 0xC7, 0xA8, 0x00, 0xA8, 0x46, 0x00, 0x32, 0x82, 0x46, 0x08, 0x25, 0x01, 0xC7, 0xA4, 0x00, 0xA0, 0x46, 0x04, 0x55, 0x81, 0x46, 0x14, 0xA2, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x16, 0xB1, 0x82, 0x0C, 0x0C, 0x8E, 0x94, 0x46, 0x06, 0x43, 0x00, 0xC7, 0xA2, 0x00, 0x7C, 0x46, 0x00, 0x10, 0x3C, 0x46, 0x02, 0x06, 0x81, 0x45, 0x02, 0x00, 0x09, 0x46, 0x00, 0xD3, 0x03, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x10, 0x00, 0x00, 0x24, 0x86, 0x07, 0x00, 0x1A, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xAA, 0x00, 0xCC, 0xC7, 0xA8, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xA4, 0x82, 0x46, 0x12, 0x51, 0x00, 0x46, 0x0C, 0xB6, 0x02, 0xC7, 0xAA, 0x00, 0x7C, 0xE7, 0xA4, 0x00, 0xCC, 0xC4, 0x24, 0x8C, 0xEC, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x18, 0x41, 0x80, 0x46, 0x04, 0x52, 0x00, 0xE7, 0xA6, 0x00, 0xC4, 0xE7, 0xA8, 0x00, 0x7C, 0xC6, 0x06, 0x00, 0x1C, 0xC6, 0x04, 0x00, 0x24, 0x46, 0x12, 0x32, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xC2, 0x02, 0xC4, 0x24, 0x8C, 0xF0, 0x46, 0x08, 0x51, 0x80, 0x46, 0x1A, 0x22, 0x82, 0x46, 0x0A, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x69, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x5E, 0x86, 0x22, 0x00, 0x16, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x86, 0x07, 0x00, 0x1A, 0x00, 0xA2, 0xC8, 0x23, 0x00, 0xC3, 0x40, 0x23, 0x44, 0x99, 0x40, 0x00, 0x44, 0x88, 0x30, 0x00, 0x00, 0xE4, 0x48, 0x23, 0x44, 0x89, 0x50, 0x00, 0x46, 0x80, 0x41, 0x20, 0x46, 0x80, 0x37, 0x20, 0x44, 0x82, 0x30, 0x00, 0xE7, 0xA4, 0x00, 0xB4, 0xC7, 0xA4, 0x00, 0xCC, 0x46, 0x80, 0x52, 0x20, 0x46, 0x80, 0x32, 0xA0, 0xE7, 0xA8, 0x00, 0xAC, 0xC7, 0xA6, 0x00, 0xC8, 0x46, 0x0A, 0x22, 0x01, 0x44, 0x83, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x22, 0xA0, 0x44, 0x84, 0x20, 0x00, 0xE7, 0xA8, 0x00, 0xA8, 0xC7, 0xA8, 0x00, 0xC4, 0x46, 0x0A, 0x30, 0x81, 0x46, 0x80, 0x21, 0xA0, 0x44, 0x80, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xE0, 0x32, 0x46, 0x06, 0x42, 0x81, 0x45, 0x01, 0x00, 0x43, 0xE7, 0xAA, 0x00, 0xA0, 0x46, 0x1C, 0x10, 0x03, 0x44, 0x80, 0x40, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x08, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xB4, 0x46, 0x00, 0x30, 0x3C, 0xC7, 0xA6, 0x00, 0xAC, 0x45, 0x01, 0x00, 0x36, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0x51, 0x02, 0xC7, 0xA8, 0x00, 0xA8, 0x46, 0x00, 0x32, 0x82, 0x46, 0x08, 0x25, 0x01, 0xC7, 0xA4, 0x00, 0xA0, 0x46, 0x04, 0x55, 0x81, 0x46, 0x14, 0xA2, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x16, 0xB1, 0x82, 0x0C, 0x0C, 0x8E, 0x94, 0x46, 0x06, 0x43, 0x00, 0xC7, 0xA2, 0x00, 0x7C, 0x46, 0x00, 0x10, 0x3C, 0x46, 0x02, 0x06, 0x81, 0x45, 0x01, 0x00, 0x26, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xAA, 0x00, 0xCC, 0xC7, 0xA8, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xA4, 0x82, 0x46, 0x12, 0x51, 0x00, 0x46, 0x0C, 0xB6, 0x02, 0xC7, 0xAA, 0x00, 0x7C, 0xE7, 0xA4, 0x00, 0xCC, 0xC4, 0x24, 0x8C, 0xF4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x18, 0x41, 0x80, 0x46, 0x04, 0x52, 0x00, 0xE7, 0xA6, 0x00, 0xC4, 0xE7, 0xA8, 0x00, 0x7C, 0xC6, 0x06, 0x00, 0x1C, 0xC6, 0x04, 0x00, 0x24, 0x46, 0x12, 0x32, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xC2, 0x02, 0xC4, 0x24, 0x8C, 0xF8, 0x46, 0x08, 0x51, 0x80, 0x46, 0x1A, 0x22, 0x82, 0x46, 0x0A, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x86, 0x22, 0x00, 0x16, 0x28, 0x41, 0x00, 0x04, 0x10, 0x20, 0x00, 0x07, 0x26, 0x73, 0x00, 0x01, 0x00, 0x02, 0x50, 0x80, 0x02, 0x2A, 0x58, 0x21, 0xAD, 0x70, 0x00, 0x18, 0x86, 0x2C, 0x00, 0x16, 0x25, 0x8D, 0x00, 0x01, 0xA6, 0x2D, 0x00, 0x16, 0x56, 0x40, 0xFE, 0x1D, 0x8E, 0x50, 0x00, 0x04, 0xC7, 0xA8, 0x00, 0xCC, 0x02, 0x60, 0x10, 0x25, 0xE6, 0x28, 0x00, 0x00, 0xC7, 0xA4, 0x00, 0xC4, 0xE6, 0x24, 0x00, 0x08, 0x8F, 0xBF, 0x00, 0x54, 0x8F, 0xB3, 0x00, 0x50, 0x8F, 0xB2, 0x00, 0x4C, 0x8F, 0xB1, 0x00, 0x48, 0x8F, 0xB0, 0x00, 0x44, 0xD7, 0xBE, 0x00, 0x38, 0xD7, 0xBC, 0x00, 0x30, 0xD7, 0xBA, 0x00, 0x28, 0xD7, 0xB8, 0x00, 0x20, 0xD7, 0xB6, 0x00, 0x18, 0xD7, 0xB4, 0x00, 0x10, 0x03, 0xE0, 0x00, 0x08, 0x27, 0xBD, 0x00, 0xE0
+            0x27, 0xBD, 0xFF, 0x20, 0xAF, 0xBF, 0x00, 0x54, 0xAF, 0xB3, 0x00, 0x50, 0xAF, 0xB2, 0x00, 0x4C, 0xAF, 0xB1, 0x00, 0x48, 0xAF, 0xB0, 0x00, 0x44, 0xF7, 0xBE, 0x00, 0x38, 0xF7, 0xBC, 0x00, 0x30, 0xF7, 0xBA, 0x00, 0x28, 0xF7, 0xB8, 0x00, 0x20, 0xF7, 0xB6, 0x00, 0x18, 0xF7, 0xB4, 0x00, 0x10, 0xC4, 0xAA, 0x00, 0x10, 0x3C, 0x01, 0x43, 0x48, 0x44, 0x81, 0x00, 0x00, 0xE7, 0xAA, 0x00, 0xD0, 0xC4, 0xA4, 0x00, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x00, 0xA0, 0x88, 0x25, 0xE7, 0xA4, 0x00, 0xCC, 0xC4, 0xA6, 0x00, 0x0C, 0xC4, 0xA8, 0x00, 0x04, 0x00, 0x80, 0x90, 0x25, 0x00, 0x00, 0x98, 0x25, 0x46, 0x06, 0x42, 0x80, 0xC7, 0xA8, 0x00, 0xD0, 0x44, 0x81, 0x30, 0x00, 0x46, 0x08, 0x00, 0x3C, 0xE7, 0xAA, 0x00, 0xC8, 0x46, 0x06, 0x42, 0x81, 0xC4, 0xA4, 0x00, 0x08, 0xE7, 0xAA, 0x00, 0x7C, 0x45, 0x00, 0x00, 0x02, 0xE7, 0xA4, 0x00, 0xC4, 0xE7, 0xA0, 0x00, 0xD0, 0x52, 0x40, 0x01, 0xF2, 0xC7, 0xA8, 0x00, 0xCC, 0x8E, 0x50, 0x00, 0x04, 0xC7, 0xA4, 0x00, 0xC8, 0x8E, 0x52, 0x00, 0x00, 0x86, 0x0E, 0x00, 0x06, 0x44, 0x8E, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x32, 0xA0, 0x46, 0x0A, 0x20, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xE4, 0x00, 0x00, 0x00, 0x00, 0x86, 0x0F, 0x00, 0x08, 0x44, 0x8F, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x41, 0xA0, 0x46, 0x04, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xDC, 0x00, 0x00, 0x00, 0x00, 0xC6, 0x0A, 0x00, 0x1C, 0xC7, 0xA4, 0x00, 0xCC, 0xE7, 0xAA, 0x00, 0x70, 0xC7, 0xA6, 0x00, 0x70, 0xC6, 0x08, 0x00, 0x24, 0x46, 0x04, 0x32, 0x82, 0xE7, 0xA8, 0x00, 0x6C, 0xC6, 0x08, 0x00, 0x20, 0xC7, 0xA6, 0x00, 0xC8, 0x46, 0x06, 0x41, 0x02, 0xC7, 0xA6, 0x00, 0x6C, 0x46, 0x04, 0x52, 0x00, 0xC7, 0xAA, 0x00, 0xC4, 0x46, 0x0A, 0x31, 0x02, 0xC6, 0x0A, 0x00, 0x28, 0x46, 0x04, 0x41, 0x80, 0xC7, 0xA8, 0x00, 0xD0, 0x46, 0x0A, 0x36, 0x80, 0x44, 0x80, 0x20, 0x00, 0x46, 0x1A, 0x40, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0xC5, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xD0, 0x3C, 0x3C, 0x18, 0x80, 0x36, 0x45, 0x01, 0x01, 0xC1, 0x00, 0x00, 0x00, 0x00, 0x87, 0x18, 0x11, 0x80, 0x53, 0x00, 0x00, 0x08, 0x86, 0x02, 0x00, 0x00, 0x82, 0x19, 0x00, 0x04, 0x33, 0x28, 0x00, 0x02, 0x51, 0x00, 0x00, 0x1C, 0x86, 0x04, 0x00, 0x0E, 0x10, 0x00, 0x01, 0xB8, 0x00, 0x00, 0x00, 0x00, 0x86, 0x02, 0x00, 0x00, 0x24, 0x01, 0x00, 0x72, 0x10, 0x41, 0x01, 0xB4, 0x24, 0x01, 0x00, 0x7B, 0x14, 0x41, 0x00, 0x13, 0x3C, 0x02, 0x80, 0x36, 0x8C, 0x42, 0x11, 0x60, 0x10, 0x40, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x84, 0x49, 0x00, 0x74, 0x31, 0x2A, 0x00, 0x40, 0x15, 0x40, 0x01, 0xAB, 0x00, 0x00, 0x00, 0x00, 0x10, 0x40, 0x00, 0x0A, 0x3C, 0x0B, 0x80, 0x36, 0x8D, 0x6B, 0x11, 0x58, 0x3C, 0x0C, 0x80, 0x33, 0x55, 0x62, 0x00, 0x07, 0x86, 0x04, 0x00, 0x0E, 0x8D, 0x8C, 0xD9, 0x3C, 0x8D, 0x8D, 0x00, 0x04, 0x31, 0xAE, 0x00, 0x02, 0x15, 0xC0, 0x01, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x86, 0x04, 0x00, 0x0E, 0x86, 0x09, 0x00, 0x14, 0x86, 0x02, 0x00, 0x0A, 0x86, 0x0F, 0x00, 0x10, 0x01, 0x24, 0x50, 0x23, 0x44, 0x8A, 0x20, 0x00, 0x86, 0x03, 0x00, 0x0C, 0x86, 0x19, 0x00, 0x12, 0x46, 0x80, 0x22, 0x20, 0x01, 0xE2, 0xC0, 0x23, 0x44, 0x98, 0x30, 0x00, 0x03, 0x23, 0x40, 0x23, 0x44, 0x88, 0x50, 0x00, 0x46, 0x80, 0x37, 0xA0, 0xE7, 0xA8, 0x00, 0xB8, 0x86, 0x0B, 0x00, 0x16, 0x3C, 0x01, 0x3F, 0x80, 0x01, 0x62, 0x60, 0x23, 0x44, 0x8C, 0x30, 0x00, 0x46, 0x80, 0x56, 0x20, 0x46, 0x80, 0x32, 0xA0, 0xE7, 0xAA, 0x00, 0xB4, 0x86, 0x0D, 0x00, 0x18, 0x86, 0x0F, 0x00, 0x1A, 0xE7, 0xA8, 0x00, 0x58, 0x01, 0xA3, 0x70, 0x23, 0x44, 0x8E, 0x20, 0x00, 0x01, 0xE4, 0xC0, 0x23, 0x44, 0x98, 0x30, 0x00, 0x46, 0x80, 0x27, 0x20, 0x44, 0x82, 0x40, 0x00, 0xE7, 0xAA, 0x00, 0x5C, 0x44, 0x83, 0x50, 0x00, 0x46, 0x80, 0x31, 0x20, 0xC7, 0xA6, 0x00, 0xCC, 0x46, 0x80, 0x42, 0x20, 0xE7, 0xA4, 0x00, 0xAC, 0xE7, 0xA4, 0x00, 0x60, 0x44, 0x84, 0x20, 0x00, 0x46, 0x80, 0x52, 0xA0, 0x46, 0x08, 0x31, 0x81, 0xC7, 0xA8, 0x00, 0xC8, 0x46, 0x80, 0x21, 0x20, 0xE7, 0xA6, 0x00, 0xA8, 0xE7, 0xA6, 0x00, 0x64, 0x46, 0x0A, 0x42, 0x01, 0xC7, 0xAA, 0x00, 0xC4, 0x46, 0x04, 0x52, 0x81, 0x46, 0x1E, 0xF1, 0x02, 0xE7, 0xA8, 0x00, 0xA4, 0x46, 0x18, 0xC1, 0x82, 0xE7, 0xAA, 0x00, 0xA0, 0x46, 0x06, 0x21, 0x00, 0xC7, 0xA6, 0x00, 0x58, 0xE7, 0xA8, 0x00, 0x58, 0x46, 0x06, 0x32, 0x02, 0x46, 0x08, 0x24, 0x80, 0xC7, 0xA4, 0x00, 0x5C, 0xE7, 0xAA, 0x00, 0x5C, 0x46, 0x04, 0x22, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0xE2, 0x82, 0x46, 0x0A, 0x42, 0x00, 0xC7, 0xAA, 0x00, 0x60, 0xE7, 0xA6, 0x00, 0x60, 0x46, 0x0A, 0x51, 0x82, 0x46, 0x06, 0x40, 0x00, 0x46, 0x04, 0xF2, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0xC1, 0x82, 0x46, 0x06, 0x42, 0x00, 0xC7, 0xA6, 0x00, 0x60, 0xE7, 0xA4, 0x00, 0x60, 0x46, 0x0A, 0x31, 0x02, 0x46, 0x04, 0x43, 0x80, 0x46, 0x00, 0x92, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x0E, 0x71, 0x02, 0x46, 0x04, 0x42, 0x01, 0x44, 0x81, 0x20, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x08, 0x20, 0x83, 0xC7, 0xA4, 0x00, 0x64, 0xE7, 0xA6, 0x00, 0x64, 0xC7, 0xA6, 0x00, 0x58, 0x46, 0x1E, 0x22, 0x02, 0xE7, 0xAA, 0x00, 0x58, 0x46, 0x18, 0x32, 0x82, 0x46, 0x0A, 0x42, 0x00, 0xC7, 0xAA, 0x00, 0x5C, 0xE7, 0xA4, 0x00, 0x5C, 0xC7, 0xA4, 0x00, 0x64, 0x46, 0x04, 0x51, 0x02, 0x46, 0x04, 0x45, 0x00, 0xC7, 0xA4, 0x00, 0x60, 0xC7, 0xA8, 0x00, 0x5C, 0x46, 0x04, 0x42, 0x02, 0x00, 0x00, 0x00, 0x00, 0x46, 0x1C, 0x31, 0x02, 0x46, 0x04, 0x41, 0x80, 0xC7, 0xA8, 0x00, 0x58, 0x46, 0x08, 0x51, 0x02, 0x46, 0x04, 0x35, 0x80, 0x46, 0x14, 0x02, 0x82, 0x44, 0x80, 0x20, 0x00, 0x46, 0x16, 0x72, 0x02, 0x46, 0x08, 0x51, 0x81, 0x46, 0x02, 0x34, 0x02, 0x46, 0x04, 0x80, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x2B, 0x00, 0x00, 0x00, 0x00, 0x44, 0x81, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x10, 0x50, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x26, 0x44, 0x80, 0x40, 0x00, 0x46, 0x16, 0x92, 0x02, 0x44, 0x80, 0x50, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x14, 0x71, 0x82, 0x46, 0x06, 0x41, 0x01, 0x46, 0x02, 0x20, 0x02, 0x46, 0x0A, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x1C, 0x44, 0x80, 0x40, 0x00, 0x44, 0x81, 0x40, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x00, 0x40, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x16, 0x44, 0x80, 0x40, 0x00, 0x46, 0x00, 0x81, 0x00, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xD0, 0x46, 0x04, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x0F, 0x44, 0x80, 0x40, 0x00, 0x46, 0x1A, 0x50, 0x01, 0xC7, 0xA6, 0x00, 0x70, 0xC7, 0xA8, 0x00, 0xCC, 0x46, 0x00, 0x31, 0x02, 0xC7, 0xA6, 0x00, 0xC4, 0x46, 0x04, 0x42, 0x80, 0xC7, 0xA8, 0x00, 0x6C, 0x46, 0x00, 0x41, 0x02, 0xE7, 0xAA, 0x00, 0xCC, 0x46, 0x04, 0x32, 0x80, 0xE7, 0xAA, 0x00, 0xC4, 0x10, 0x00, 0x00, 0xFD, 0x86, 0x22, 0x00, 0x16, 0x44, 0x80, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x08, 0xD0, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x01, 0x00, 0xC7, 0xAE, 0x00, 0x7C, 0x46, 0x0E, 0x74, 0x02, 0x46, 0x0E, 0x84, 0x00, 0x44, 0x80, 0x30, 0x00, 0xC7, 0xA4, 0x00, 0xA4, 0x46, 0x06, 0xC0, 0x32, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x3F, 0x44, 0x80, 0x50, 0x00, 0x46, 0x18, 0x20, 0x03, 0x44, 0x80, 0x50, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x0A, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x38, 0x44, 0x80, 0x50, 0x00, 0x44, 0x81, 0x40, 0x00, 0xC7, 0xAA, 0x00, 0xB8, 0x46, 0x00, 0x40, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x32, 0x44, 0x80, 0x50, 0x00, 0x46, 0x00, 0xF1, 0x82, 0xC7, 0xA4, 0x00, 0xA8, 0x46, 0x00, 0x52, 0x02, 0x46, 0x04, 0x35, 0x81, 0xC7, 0xA6, 0x00, 0xA0, 0x46, 0x06, 0x46, 0x01, 0x46, 0x16, 0xB1, 0x02, 0x46, 0x18, 0xC2, 0x82, 0x46, 0x0A, 0x23, 0x00, 0x46, 0x0C, 0x80, 0x3C, 0x45, 0x03, 0x00, 0x26, 0x44, 0x80, 0x50, 0x00, 0x0C, 0x0C, 0x8E, 0x94, 0x00, 0x00, 0x00, 0x00, 0xC7, 0xA8, 0x00, 0x7C, 0x46, 0x00, 0x40, 0x3C, 0x46, 0x08, 0x06, 0x81, 0x45, 0x03, 0x00, 0x1F, 0x44, 0x80, 0x50, 0x00, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xA6, 0x00, 0xCC, 0xC7, 0xAA, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xB4, 0x82, 0x46, 0x12, 0x31, 0x00, 0x46, 0x0C, 0xC5, 0x02, 0xC7, 0xA6, 0x00, 0x7C, 0xE7, 0xA4, 0x00, 0xCC, 0xC4, 0x24, 0x8C, 0xE4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x14, 0x52, 0x00, 0x46, 0x04, 0x32, 0x80, 0xE7, 0xA8, 0x00, 0xC4, 0xE7, 0xAA, 0x00, 0x7C, 0xC6, 0x08, 0x00, 0x1C, 0xC6, 0x04, 0x00, 0x24, 0x46, 0x12, 0x41, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xA2, 0x82, 0xC4, 0x24, 0x8C, 0xE8, 0x46, 0x0A, 0x32, 0x00, 0x46, 0x1A, 0x21, 0x82, 0x46, 0x06, 0x40, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0xBD, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0xB2, 0x86, 0x22, 0x00, 0x16, 0x44, 0x80, 0x50, 0x00, 0xC7, 0xA4, 0x00, 0xA4, 0x46, 0x0A, 0xE0, 0x32, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x4D, 0x86, 0x02, 0x00, 0x10, 0x46, 0x1C, 0x20, 0x03, 0x44, 0x80, 0x40, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x08, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x03, 0x00, 0x08, 0x86, 0x02, 0x00, 0x10, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xB4, 0x46, 0x00, 0x30, 0x3C, 0xC7, 0xA6, 0x00, 0xAC, 0x45, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x10, 0x00, 0x00, 0x3E, 0x86, 0x07, 0x00, 0x1A, 0x46, 0x00, 0x51, 0x02, 0xC7, 0xA8, 0x00, 0xA8, 0x46, 0x00, 0x32, 0x82, 0x46, 0x08, 0x25, 0x01, 0xC7, 0xA4, 0x00, 0xA0, 0x46, 0x04, 0x55, 0x81, 0x46, 0x14, 0xA2, 0x02, 0x46, 0x16, 0xB1, 0x82, 0x46, 0x06, 0x43, 0x00, 0x46, 0x0C, 0x80, 0x3C, 0x45, 0x03, 0x00, 0x2D, 0x86, 0x02, 0x00, 0x10, 0x0C, 0x0C, 0x8E, 0x94, 0x00, 0x00, 0x00, 0x00, 0xC7, 0xA2, 0x00, 0x7C, 0x46, 0x00, 0x10, 0x3C, 0x46, 0x02, 0x06, 0x81, 0x45, 0x02, 0x00, 0x09, 0x46, 0x00, 0xD3, 0x03, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x10, 0x00, 0x00, 0x24, 0x86, 0x07, 0x00, 0x1A, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xAA, 0x00, 0xCC, 0xC7, 0xA8, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xA4, 0x82, 0x46, 0x12, 0x51, 0x00, 0x46, 0x0C, 0xB6, 0x02, 0xC7, 0xAA, 0x00, 0x7C, 0xE7, 0xA4, 0x00, 0xCC, 0xC4, 0x24, 0x8C, 0xEC, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x18, 0x41, 0x80, 0x46, 0x04, 0x52, 0x00, 0xE7, 0xA6, 0x00, 0xC4, 0xE7, 0xA8, 0x00, 0x7C, 0xC6, 0x06, 0x00, 0x1C, 0xC6, 0x04, 0x00, 0x24, 0x46, 0x12, 0x32, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xC2, 0x02, 0xC4, 0x24, 0x8C, 0xF0, 0x46, 0x08, 0x51, 0x80, 0x46, 0x1A, 0x22, 0x82, 0x46, 0x0A, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x6C, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x61, 0x86, 0x22, 0x00, 0x16, 0x86, 0x02, 0x00, 0x10, 0x86, 0x03, 0x00, 0x12, 0x86, 0x04, 0x00, 0x14, 0x86, 0x05, 0x00, 0x16, 0x86, 0x06, 0x00, 0x18, 0x86, 0x07, 0x00, 0x1A, 0x00, 0xA2, 0xC8, 0x23, 0x00, 0xC3, 0x40, 0x23, 0x44, 0x99, 0x40, 0x00, 0x44, 0x88, 0x30, 0x00, 0x00, 0xE4, 0x48, 0x23, 0x44, 0x89, 0x50, 0x00, 0x46, 0x80, 0x41, 0x20, 0x46, 0x80, 0x37, 0x20, 0x44, 0x82, 0x30, 0x00, 0xE7, 0xA4, 0x00, 0xB4, 0xC7, 0xA4, 0x00, 0xCC, 0x46, 0x80, 0x52, 0x20, 0x46, 0x80, 0x32, 0xA0, 0xE7, 0xA8, 0x00, 0xAC, 0xC7, 0xA6, 0x00, 0xC8, 0x46, 0x0A, 0x22, 0x01, 0x44, 0x83, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x80, 0x22, 0xA0, 0x44, 0x84, 0x20, 0x00, 0xE7, 0xA8, 0x00, 0xA8, 0xC7, 0xA8, 0x00, 0xC4, 0x46, 0x0A, 0x30, 0x81, 0x46, 0x80, 0x21, 0xA0, 0x44, 0x80, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xE0, 0x32, 0x46, 0x06, 0x42, 0x81, 0x45, 0x01, 0x00, 0x46, 0xE7, 0xAA, 0x00, 0xA0, 0x46, 0x1C, 0x10, 0x03, 0x44, 0x80, 0x40, 0x00, 0x3C, 0x01, 0x3F, 0x80, 0x46, 0x08, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x44, 0x81, 0x30, 0x00, 0xC7, 0xAA, 0x00, 0xB4, 0x46, 0x00, 0x30, 0x3C, 0xC7, 0xA6, 0x00, 0xAC, 0x45, 0x01, 0x00, 0x39, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0x51, 0x02, 0xC7, 0xA8, 0x00, 0xA8, 0x46, 0x00, 0x32, 0x82, 0x46, 0x08, 0x25, 0x01, 0xC7, 0xA4, 0x00, 0xA0, 0x46, 0x04, 0x55, 0x81, 0x46, 0x14, 0xA2, 0x02, 0x46, 0x16, 0xB1, 0x82, 0x46, 0x06, 0x43, 0x00, 0x46, 0x0C, 0x80, 0x3C, 0x45, 0x01, 0x00, 0x2D, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x8E, 0x94, 0x00, 0x00, 0x00, 0x00, 0xC7, 0xA2, 0x00, 0x7C, 0x46, 0x00, 0x10, 0x3C, 0x46, 0x02, 0x06, 0x81, 0x45, 0x01, 0x00, 0x26, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0xD3, 0x03, 0xC7, 0xAA, 0x00, 0xCC, 0xC7, 0xA8, 0x00, 0xC4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x0C, 0xA4, 0x82, 0x46, 0x12, 0x51, 0x00, 0x46, 0x0C, 0xB6, 0x02, 0xC7, 0xAA, 0x00, 0x7C, 0xE7, 0xA4, 0x00, 0xCC, 0xC4, 0x24, 0x8C, 0xF4, 0x3C, 0x01, 0x80, 0x39, 0x46, 0x18, 0x41, 0x80, 0x46, 0x04, 0x52, 0x00, 0xE7, 0xA6, 0x00, 0xC4, 0xE7, 0xA8, 0x00, 0x7C, 0xC6, 0x06, 0x00, 0x1C, 0xC6, 0x04, 0x00, 0x24, 0x46, 0x12, 0x32, 0x82, 0x00, 0x00, 0x00, 0x00, 0x46, 0x04, 0xC2, 0x02, 0xC4, 0x24, 0x8C, 0xF8, 0x46, 0x08, 0x51, 0x80, 0x46, 0x1A, 0x22, 0x82, 0x46, 0x0A, 0x30, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x01, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x86, 0x22, 0x00, 0x16, 0x28, 0x41, 0x00, 0x04, 0x10, 0x20, 0x00, 0x07, 0x26, 0x73, 0x00, 0x01, 0x00, 0x02, 0x50, 0x80, 0x02, 0x2A, 0x58, 0x21, 0xAD, 0x70, 0x00, 0x18, 0x86, 0x2C, 0x00, 0x16, 0x25, 0x8D, 0x00, 0x01, 0xA6, 0x2D, 0x00, 0x16, 0x56, 0x40, 0xFE, 0x12, 0x8E, 0x50, 0x00, 0x04, 0xC7, 0xA8, 0x00, 0xCC, 0x02, 0x60, 0x10, 0x25, 0xE6, 0x28, 0x00, 0x00, 0xC7, 0xA4, 0x00, 0xC4, 0xE6, 0x24, 0x00, 0x08, 0x8F, 0xBF, 0x00, 0x54, 0x8F, 0xB3, 0x00, 0x50, 0x8F, 0xB2, 0x00, 0x4C, 0x8F, 0xB1, 0x00, 0x48, 0x8F, 0xB0, 0x00, 0x44, 0xD7, 0xBE, 0x00, 0x38, 0xD7, 0xBC, 0x00, 0x30, 0xD7, 0xBA, 0x00, 0x28, 0xD7, 0xB8, 0x00, 0x20, 0xD7, 0xB6, 0x00, 0x18, 0xD7, 0xB4, 0x00, 0x10, 0x03, 0xE0, 0x00, 0x08, 0x27, 0xBD, 0x00, 0xE0
         };
 
         static byte[] perform_air_step_methods = new byte[]
@@ -35,6 +35,13 @@ namespace SM64CollisionPatcher
             0x27, 0xBD, 0xFF, 0xB0, 0xAF, 0xBF, 0x00, 0x14, 0xAF, 0xA4, 0x00, 0x50, 0x8F, 0xAE, 0x00, 0x50, 0x3C, 0x01, 0x41, 0x20, 0x44, 0x81, 0x30, 0x00, 0xC5, 0xC4, 0x00, 0x54, 0x46, 0x06, 0x20, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x00, 0x00, 0x5E, 0xC4, 0x8A, 0x00, 0x48, 0xC4, 0x88, 0x00, 0x3C, 0x46, 0x0A, 0x42, 0x00, 0xE7, 0xA8, 0x00, 0x28, 0xC4, 0x8A, 0x00, 0x40, 0xE7, 0xAA, 0x00, 0x2C, 0xC4, 0x92, 0x00, 0x50, 0xC4, 0x90, 0x00, 0x44, 0x46, 0x12, 0x84, 0x00, 0xE7, 0xB0, 0x00, 0x30, 0x3C, 0x01, 0x41, 0xA0, 0x44, 0x81, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE7, 0xB2, 0x00, 0x38, 0x3C, 0x01, 0xC1, 0x20, 0x44, 0x81, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE7, 0xA4, 0x00, 0x34, 0x0C, 0x0E, 0x03, 0xA3, 0x27, 0xA4, 0x00, 0x28, 0x10, 0x40, 0x00, 0x49, 0x00, 0x00, 0x00, 0x00, 0xC7, 0xAC, 0x00, 0x28, 0xC7, 0xAE, 0x00, 0x2C, 0x8F, 0xA6, 0x00, 0x30, 0x0C, 0x0E, 0x06, 0x40, 0x27, 0xA7, 0x00, 0x24, 0xE7, 0xA0, 0x00, 0x20, 0x8F, 0xA8, 0x00, 0x24, 0x11, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0xC7, 0xA6, 0x00, 0x2C, 0xC7, 0xA8, 0x00, 0x20, 0x3C, 0x01, 0x43, 0x20, 0x44, 0x81, 0x80, 0x00, 0x46, 0x08, 0x32, 0x81, 0x46, 0x0A, 0x80, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x45, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00, 0x00, 0x87, 0xA9, 0x00, 0x3E, 0x00, 0x09, 0x50, 0x80, 0x03, 0xAA, 0x58, 0x21, 0x8D, 0x6B, 0x00, 0x3C, 0xAF, 0xAB, 0x00, 0x1C, 0x8F, 0xAC, 0x00, 0x1C, 0xC5, 0x8C, 0x00, 0x24, 0x0C, 0x0D, 0xEA, 0x6A, 0xC5, 0x8E, 0x00, 0x1C, 0xA7, 0xA2, 0x00, 0x1A, 0x8F, 0xAE, 0x00, 0x50, 0x87, 0xAD, 0x00, 0x1A, 0x85, 0xCF, 0x00, 0x2E, 0x01, 0xAF, 0xC0, 0x23, 0xA7, 0xB8, 0x00, 0x18, 0x87, 0xB9, 0x00, 0x18, 0x2B, 0x21, 0xC0, 0x01, 0x14, 0x20, 0x00, 0x24, 0x00, 0x00, 0x00, 0x00, 0x2B, 0x21, 0x40, 0x00, 0x10, 0x20, 0x00, 0x21, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xA8, 0x00, 0x1C, 0x3C, 0x01, 0x41, 0xF0, 0x44, 0x81, 0x20, 0x00, 0xC5, 0x12, 0x00, 0x1C, 0xC7, 0xA8, 0x00, 0x28, 0x8F, 0xA9, 0x00, 0x50, 0x46, 0x04, 0x91, 0x82, 0x46, 0x06, 0x42, 0x81, 0xE5, 0x2A, 0x00, 0x3C, 0x8F, 0xAA, 0x00, 0x1C, 0x3C, 0x01, 0x41, 0xF0, 0x44, 0x81, 0x90, 0x00, 0xC5, 0x50, 0x00, 0x24, 0xC7, 0xA8, 0x00, 0x30, 0x8F, 0xAB, 0x00, 0x50, 0x46, 0x12, 0x81, 0x02, 0x46, 0x04, 0x41, 0x81, 0xE5, 0x66, 0x00, 0x44, 0x8F, 0xAC, 0x00, 0x50, 0xA5, 0x80, 0x00, 0x2C, 0x87, 0xAE, 0x00, 0x1A, 0x8F, 0xAF, 0x00, 0x50, 0x34, 0x01, 0x80, 0x00, 0x01, 0xC1, 0x68, 0x21, 0xA5, 0xED, 0x00, 0x2E, 0x8F, 0xA4, 0x00, 0x50, 0x24, 0x05, 0x05, 0x4E, 0x0C, 0x09, 0x4B, 0x3D, 0x00, 0x00, 0x30, 0x25, 0x8F, 0xA4, 0x00, 0x50, 0x0C, 0x09, 0x42, 0x6E, 0x24, 0x05, 0x00, 0x1C, 0x10, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xBF, 0x00, 0x14, 0x27, 0xBD, 0x00, 0x50, 0x03, 0xE0, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00
         };
 
+        //Apply a larger margin for wall triangles.
+        //Normally triangles are classified as walls when the y-component of their normal is between -0.01 and 0.01.
+        //This often causes near-vertical surfaces to not be classified as walls even though they were meant to be walls,
+        //creating extremely steep floors and ceilings (the latter of which in turn create "invisible walls" when exposed).
+        //Increasing this margin avoids many of those occurences.
+        const double new_y_normal_threshold = 0.05;
+
         unsafe static bool CompareBytes(byte* original, byte[] compare)
         {
             for (int i = 0; i < compare.Length; i++)
@@ -63,6 +70,68 @@ namespace SM64CollisionPatcher
             target[offset + 3] = (byte)(targetAddress >> 0x02);
         }
 
+        //Where the extended boundaries patch loads its scale into S4 (lui s4, scale; mtc1 s4, f20).
+        static readonly int[] boundaryScaleLoads = new int[] { 0xFD428, 0xFDAD0 };
+
+        //Returns the factor the extended boundaries patch enlarges the level boundaries by, or 1 if it is not applied.
+        //The scale is read from the upper half of the float it loads, only powers of two are supported.
+        static int DetectBoundaryScale(byte[] rom)
+        {
+            foreach (var offset in boundaryScaleLoads)
+            {
+                if (rom[offset] != 0x3C || rom[offset + 1] != 0x14 || rom[offset + 4] != 0x44 || rom[offset + 5] != 0x94 || rom[offset + 6] != 0xA0 || rom[offset + 7] != 0x00)
+                    continue;
+                var scale = BitConverter.ToSingle(BitConverter.GetBytes((uint)(rom[offset + 2] << 24 | rom[offset + 3] << 16)), 0);
+                if (scale == 2 || scale == 4 || scale == 8)
+                    return (int)scale;
+            }
+            return 1;
+        }
+
+        //The LUIs in find_wall_collisions_from_list_ext_bounds that load the boundary scale:
+        //1 / scale to scale the sphere down on entry, and scale to scale the result back up on both returns.
+        const int extBoundsDownScaleLoad = 0x34;
+        static readonly int[] extBoundsUpScaleLoads = new int[] { 0xD0, 0x894 };
+
+        static void PutFloatLUI(float value, byte[] target, int offset)
+        {
+            if (target[offset] != 0x3C || target[offset + 1] != 0x01)
+                throw new Exception($"Expected a LUI of a float constant at 0x{offset.ToString("X")} of the wall routine.");
+            var bits = BitConverter.ToUInt32(BitConverter.GetBytes(value), 0);
+            target[offset + 2] = (byte)(bits >> 24);
+            target[offset + 3] = (byte)(bits >> 16);
+        }
+
+        //The BC1T of each wall routine that skips the edges of a wall if the sphere is behind its plane.
+        const int regularBoundsEdgeBranch = 0x448;
+        const int extBoundsEdgeBranch = 0x488;
+
+        static void PutBranchAlways(byte[] target, int offset)
+        {
+            if (target[offset] != 0x45 || target[offset + 1] != 0x01)
+                throw new Exception($"Expected a BC1T at 0x{offset.ToString("X")} of the wall routine.");
+            target[offset] = 0x10; //beq zero, zero
+            target[offset + 1] = 0x00;
+        }
+
+        //Returns find_wall_collisions_from_list for a boundary scale and tier. Regular boundaries use the routine without
+        //any scaling, other scales a copy of the extended boundaries routine with the scale constants replaced. The scales
+        //are powers of two, so both constants are exact and the copy computes the same as a build with that EXT_BOUNDARIES_SIZE.
+        //The face tier always takes the branch past the edges, like a build with WALL_ROUTINE_TIER set to WALL_TIER_FACE.
+        static byte[] GetWallRoutine(int boundaryScale, WallTier tier)
+        {
+            var routine = (byte[])(boundaryScale == 1 ? find_wall_collisions_from_list_regular_bounds : find_wall_collisions_from_list_ext_bounds).Clone();
+            if (boundaryScale > 1)
+            {
+                PutFloatLUI(1.0f / boundaryScale, routine, extBoundsDownScaleLoad);
+                foreach (var offset in extBoundsUpScaleLoads)
+                    PutFloatLUI(boundaryScale, routine, offset);
+            }
+            if (tier == WallTier.Face)
+                PutBranchAlways(routine, boundaryScale == 1 ? regularBoundsEdgeBranch : extBoundsEdgeBranch);
+            return routine;
+        }
+
         unsafe static void Main(string[] args)
         {
             var baseROMOffset = 0x01200000;
@@ -74,19 +143,90 @@ namespace SM64CollisionPatcher
             var offsetExtBounds1 = 0x5FF6 - 0x5590;
             int offsetExtBounds2 = 0x5FE6 - 0x5590;
 
-            if (args.Length < 1)
+            //Options start with "--", the first other argument is the ROM.
+            string file = null;
+            bool analyzeOnly = false;
+            int budgetBoundaryScale = 0; //Detected from the ROM unless given
+            var wallTier = WallTier.Full;
+            string argumentError = null;
+            foreach (var arg in args)
+            {
+                if (arg == "--analyze")
+                    analyzeOnly = true;
+                else if (arg.StartsWith("--budget-boundary-scale="))
+                {
+                    //Only changes the boundary scale the budget analysis assumes. The wall routine written to the ROM
+                    //always uses the scale of the extended boundaries hack found in the ROM.
+                    var scale = arg.Substring("--budget-boundary-scale=".Length);
+                    if (!int.TryParse(scale, out budgetBoundaryScale) || (budgetBoundaryScale != 1 && budgetBoundaryScale != 2 && budgetBoundaryScale != 4 && budgetBoundaryScale != 8))
+                        argumentError = $"Invalid budget boundary scale \"{scale}\". Use --budget-boundary-scale=1, 2, 4 or 8.";
+                }
+                else if (arg.StartsWith("--wall-tier="))
+                {
+                    //How much of a wall the new routine pushes out of: full rounds the three edges, face only pushes out of the face.
+                    var tier = arg.Substring("--wall-tier=".Length);
+                    if (tier == "full")
+                        wallTier = WallTier.Full;
+                    else if (tier == "face")
+                        wallTier = WallTier.Face;
+                    else if (tier == "hybrid")
+                        argumentError = "The hybrid wall tier needs convex edges marked by the surface loader, which the loader of the ROM does not do. It is only available in builds of the C source (WALL_ROUTINE_TIER).";
+                    else
+                        argumentError = $"Unknown wall tier \"{tier}\". Use --wall-tier=full or --wall-tier=face.";
+                }
+                else if (file == null)
+                    file = arg.Trim();
+            }
+
+            if (file == null)
             {
                 Console.WriteLine("No command line arguments supplied. Please specificy a ROM to apply this patch to.");
                 Console.WriteLine("\nPress any key to exit.");
                 Console.ReadLine();
                 return;
             }
+            if (argumentError != null)
+            {
+                Console.WriteLine(argumentError);
+                Console.WriteLine("\nPress any key to exit.");
+                Console.ReadLine();
+                return;
+            }
             GCHandle handle = default(GCHandle);
             try
             {
                 var anomalyBuilder = new System.Text.StringBuilder();
-                var file = args[0].Trim();
                 var rom = System.IO.File.ReadAllBytes(file);
+                var extBoundsScale = DetectBoundaryScale(rom);
+                if (budgetBoundaryScale == 0)
+                    budgetBoundaryScale = extBoundsScale;
+
+                //Estimate the collision cost of every level with the new wall routine before patching,
+                //so that authors find out about levels that may lag on console.
+                //Use --analyze to only print the full report, without patching.
+                try
+                {
+                    var budget = CollisionBudget.Analyze(rom, budgetBoundaryScale, wallTier, new_y_normal_threshold);
+                    if (analyzeOnly)
+                    {
+                        Console.WriteLine($"Collision budget of {budget.Count} level areas:");
+                        CollisionBudget.PrintReport(budget, false);
+                        Console.WriteLine("\nPress any key to exit.");
+                        Console.ReadLine();
+                        return;
+                    }
+                    foreach (var area in budget)
+                        if (area.AtRisk)
+                            anomalyBuilder.AppendLine($"Collision of {area.Name} is estimated to take {area.FrameShare * 100:F0}% of a frame. Run with --analyze for details.");
+                    if (budget.Count == 0)
+                        anomalyBuilder.AppendLine("No level collision was found to estimate the collision budget.");
+                }
+                catch (Exception ex)
+                {
+                    if (analyzeOnly)
+                        throw;
+                    anomalyBuilder.AppendLine($"Collision budget analysis failed: {ex.Message}");
+                }
 
                 handle = GCHandle.Alloc(rom);
                 var ptr = Marshal.UnsafeAddrOfPinnedArrayElement(rom, 0);
@@ -162,19 +302,18 @@ namespace SM64CollisionPatcher
                 bool extBoundaries = false;
                 //Extended boundaries patch uses the S4 register illegally. This breaks the new collision routine.
                 //The fix uses AT instead - however the illegal usage is not present in both locations in all ROMs. Cool.
-                var uses_S4_illegally = new byte[] { 0x3C, 0x14, 0x40, 0x80, 0x44, 0x94, 0xA0, 0x00 };
-                var uses_AT_instead = new byte[] { 0x3C, 0x01, 0x40, 0x80, 0x44, 0x81, 0xA0, 0x00 };
-                if (CompareBytes((byte*)IntPtr.Add(ptr, 0xFD428), uses_S4_illegally))
+                //The loaded value is the boundary scale, which is kept.
+                var scaleBits = BitConverter.ToUInt32(BitConverter.GetBytes((float)extBoundsScale), 0);
+                var uses_S4_illegally = new byte[] { 0x3C, 0x14, (byte)(scaleBits >> 24), (byte)(scaleBits >> 16), 0x44, 0x94, 0xA0, 0x00 };
+                var uses_AT_instead = new byte[] { 0x3C, 0x01, (byte)(scaleBits >> 24), (byte)(scaleBits >> 16), 0x44, 0x81, 0xA0, 0x00 };
+                foreach (var offset in boundaryScaleLoads)
                 {
-                    WriteBytes((byte*)IntPtr.Add(ptr, 0xFD428), uses_AT_instead);
-                    Console.WriteLine($"Fixed illegal usage of S4 register in the extended boundaries hack at 0xFD428 (0x4 bytes)");
-                    extBoundaries = true;
-                }
-                if (CompareBytes((byte*)IntPtr.Add(ptr, 0xFDAD0), uses_S4_illegally))
-                {
-                    WriteBytes((byte*)IntPtr.Add(ptr, 0xFDAD0), uses_AT_instead);
-                    Console.WriteLine($"Fixed illegal usage of S4 register in the extended boundaries hack at 0xFDAD0 (0x4 bytes)");
-                    extBoundaries = true;
+                    if (extBoundsScale > 1 && CompareBytes((byte*)IntPtr.Add(ptr, offset), uses_S4_illegally))
+                    {
+                        WriteBytes((byte*)IntPtr.Add(ptr, offset), uses_AT_instead);
+                        Console.WriteLine($"Fixed illegal usage of S4 register in the extended boundaries hack at 0x{offset.ToString("X")} (0x4 bytes)");
+                        extBoundaries = true;
+                    }
                 }
 
                 if (hasCalls)
@@ -187,15 +326,17 @@ namespace SM64CollisionPatcher
                         WriteBytes((byte*)IntPtr.Add(ptr, 0xFDD88), new byte[] { 0x00, 0x00, 0x20, 0x25, 0x0C, 0x0E, 0x01, 0xA4, 0x8F, 0xA5, 0x00, 0x38 });
                         Console.WriteLine($"Applied a band-aid fix to repair camera on ext-boundaries ROMs that is needed for an unknown reason at 0xFDD88 (0xC bytes)");
 
-                        WriteBytes((byte*)IntPtr.Add(ptr, baseROMOffset), find_wall_collisions_from_list_ext_bounds);
-                        Console.WriteLine($"New find_wall_collisons_from_list function for extended boundaries written to {baseROMOffset.ToString("X")} ({find_wall_collisions_from_list_ext_bounds.Length.ToString("X")} bytes)");
+                        var wallRoutineForScale = GetWallRoutine(extBoundsScale, wallTier);
+                        WriteBytes((byte*)IntPtr.Add(ptr, baseROMOffset), wallRoutineForScale);
+                        Console.WriteLine($"New find_wall_collisons_from_list function ({wallTier.ToString().ToLower()} tier) for {extBoundsScale}x extended boundaries written to {baseROMOffset.ToString("X")} ({wallRoutineForScale.Length.ToString("X")} bytes)");
                         Console.WriteLine($"Wallkick angles are located at {(baseROMOffset + offsetExtBounds1).ToString("X")} and {(baseROMOffset + offsetExtBounds2).ToString("X")}");
                     }
                     else
                     {
                         //If no extended boundaries patch has been detected, patch the find_wall_collisions_from_list function for regular boundaries in.
-                        WriteBytes((byte*)IntPtr.Add(ptr, baseROMOffset), find_wall_collisions_from_list_regular_bounds);
-                        Console.WriteLine($"New find_wall_collisons_from_list function for regular boundaries written to {baseROMOffset.ToString("X")} ({find_wall_collisions_from_list_regular_bounds.Length.ToString("X")} bytes)");
+                        var wallRoutineForScale = GetWallRoutine(1, wallTier);
+                        WriteBytes((byte*)IntPtr.Add(ptr, baseROMOffset), wallRoutineForScale);
+                        Console.WriteLine($"New find_wall_collisons_from_list function ({wallTier.ToString().ToLower()} tier) for regular boundaries written to {baseROMOffset.ToString("X")} ({wallRoutineForScale.Length.ToString("X")} bytes)");
                         Console.WriteLine($"Wallkick angles are located at {(baseROMOffset + offsetRegularBounds1).ToString("X")} and {(baseROMOffset + offsetRegularBounds2).ToString("X")}");
                     }
 
@@ -208,6 +349,21 @@ namespace SM64CollisionPatcher
                     //Write the new perform_air_step method at its original location.
                     WriteBytes((byte*)IntPtr.Add(ptr, 0x11B24), perform_air_step);
                     Console.WriteLine($"New perform_air_step function written at 0x11B24 ({perform_air_step.Length.ToString("X")} bytes)");
+
+                    //Run the new find_wall_collisions_from_list against synthetic walls in the R4300 interpreter and check the JALs of
+                    //the new subroutines, to catch payloads that were assembled or relocated wrong.
+                    //The extended boundaries routine is built for geometry scaled down by the boundary scale.
+                    Console.WriteLine("\nChecking the new subroutines in the R4300 interpreter:");
+                    var wallRoutine = (uint)(0x80000000 | baseRAMOffset);
+                    var payloads = new System.Collections.Generic.Dictionary<string, System.Collections.Generic.KeyValuePair<uint, int>>();
+                    payloads["find_wall_collisions_from_list"] = new System.Collections.Generic.KeyValuePair<uint, int>(wallRoutine,
+                        extBoundaries ? find_wall_collisions_from_list_ext_bounds.Length : find_wall_collisions_from_list_regular_bounds.Length);
+                    payloads["perform_air_step dependencies"] = new System.Collections.Generic.KeyValuePair<uint, int>(wallRoutine + 0x900, perform_air_step_methods.Length);
+                    payloads["perform_air_step"] = new System.Collections.Generic.KeyValuePair<uint, int>(0x80256B24, perform_air_step.Length); //ROM 0x11B24
+                    var payloadErrors = PayloadCheck.Run(rom, wallRoutine, extBoundaries ? extBoundsScale : 1, wallTier != WallTier.Face, payloads);
+                    if (payloadErrors.Length > 0)
+                        anomalyBuilder.Append(payloadErrors);
+                    Console.WriteLine($"With the {wallTier.ToString().ToLower()} tier, each wall within reach of the sphere is estimated to take {CollisionBudget.WallPushCycles(wallTier):F0} cycles to push out of.");
                 }
 
                 //check_ledge_climb_down relies on finding a wall triangle under Mario.
@@ -219,12 +375,7 @@ namespace SM64CollisionPatcher
                     Console.WriteLine("Updated check_ledge_climb_down to search for walls in front of Mario rather than under (Necessary because walls don't have backsides anymore)");
                 }
 
-                //Apply a larger margin for wall triangles.
-                //Normally triangles are classified as walls when the y-component of their normal is between -0.01 and 0.01.
-                //This often causes near-vertical surfaces to not be classified as walls even though they were meant to be walls,
-                //creating extremely steep floors and ceilings (the latter of which in turn create "invisible walls" when exposed).
-                //Increasing this margin avoids many of those occurences.
-                const double new_y_normal_threshold = 0.05;
+                //Apply a larger margin for wall triangles (see new_y_normal_threshold).
 
                 //0.01 for normal y-component to classify a surface as a wall
                 if (CompareBytes((byte*)IntPtr.Add(ptr, 0x108930), new byte[] { 0x3F, 0x84, 0x7A, 0xE1, 0x47, 0xAE, 0x14, 0x7B }))
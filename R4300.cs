@@ -0,0 +1,419 @@
+﻿using System;
+
+namespace SM64CollisionPatcher
+{
+    //A small interpreter for the integer and COP1 instructions of the R4300, to run the patched subroutines without an emulator.
+    //Memory is 8 MB of RDRAM at 0x80000000 (or 0xA0000000), big-endian. There are no exceptions, TLB, COP0 or caches;
+    //any instruction or access outside of that throws. The FPU runs with FR=0 like the game, so doubles are register pairs.
+    class R4300
+    {
+        public const uint ReturnAddress = 0x80000000; //Returning here ends Call
+
+        public byte[] RAM = new byte[0x800000];
+        public long[] GPR = new long[32];
+        public uint[] FPR = new uint[32];
+        public long HI, LO;
+        public uint FCR31;
+        public uint PC;
+        uint nextPC;
+
+        //Counters of the retired instructions since the last ResetCounters.
+        public long Instructions;
+        public long FPUOps;         //COP1 arithmetic, compares and conversions
+        public long FPUDivSqrt;     //div and sqrt, which take about 30 cycles each
+        public long Loads;
+        public long Stores;
+        public long Branches;       //Branches and jumps, taken or not
+
+        public void ResetCounters()
+        {
+            Instructions = FPUOps = FPUDivSqrt = Loads = Stores = Branches = 0;
+        }
+
+        int Physical(uint address, int size)
+        {
+            if (address < 0x80000000 || address >= 0xC0000000)
+                throw new Exception($"R4300: access to unmapped address {address.ToString("X8")} at {PC.ToString("X8")}");
+            var physical = (int)(address & 0x1FFFFFFF);
+            if (physical + size > RAM.Length)
+                throw new Exception($"R4300: access beyond RDRAM at {address.ToString("X8")} at {PC.ToString("X8")}");
+            if ((physical & (size - 1)) != 0)
+                throw new Exception($"R4300: unaligned access to {address.ToString("X8")} at {PC.ToString("X8")}");
+            return physical;
+        }
+
+        public byte Read8(uint address) => RAM[Physical(address, 1)];
+        public ushort Read16(uint address)
+        {
+            var p = Physical(address, 2);
+            return (ushort)((RAM[p] << 8) | RAM[p + 1]);
+        }
+        public uint Read32(uint address)
+        {
+            var p = Physical(address, 4);
+            return (uint)((RAM[p] << 24) | (RAM[p + 1] << 16) | (RAM[p + 2] << 8) | RAM[p + 3]);
+        }
+        public ulong Read64(uint address) => ((ulong)Read32(address) << 32) | Read32(address + 4);
+
+        public void Write8(uint address, byte value) => RAM[Physical(address, 1)] = value;
+        public void Write16(uint address, ushort value)
+        {
+            var p = Physical(address, 2);
+            RAM[p] = (byte)(value >> 8);
+            RAM[p + 1] = (byte)value;
+        }
+        public void Write32(uint address, uint value)
+        {
+            var p = Physical(address, 4);
+            RAM[p] = (byte)(value >> 24);
+            RAM[p + 1] = (byte)(value >> 16);
+            RAM[p + 2] = (byte)(value >> 8);
+            RAM[p + 3] = (byte)value;
+        }
+        public void Write64(uint address, ulong value)
+        {
+            Write32(address, (uint)(value >> 32));
+            Write32(address + 4, (uint)value);
+        }
+        public float ReadFloat(uint address) => BitConverter.ToSingle(BitConverter.GetBytes(Read32(address)), 0);
+        public void WriteFloat(uint address, float value) => Write32(address, BitConverter.ToUInt32(BitConverter.GetBytes(value), 0));
+
+        //Copies a part of the ROM to its RAM address.
+        public void Load(byte[] rom, int romStart, int romEnd, uint ramAddress)
+        {
+            Array.Copy(rom, romStart, RAM, Physical(ramAddress, 1), romEnd - romStart);
+        }
+
+        float GetS(int fs) => BitConverter.ToSingle(BitConverter.GetBytes(FPR[fs]), 0);
+        void SetS(int fd, float value) => FPR[fd] = BitConverter.ToUInt32(BitConverter.GetBytes(value), 0);
+        ulong GetPair(int fs) => ((ulong)FPR[(fs & ~1) + 1] << 32) | FPR[fs & ~1];
+        void SetPair(int fd, ulong value)
+        {
+            FPR[fd & ~1] = (uint)value;
+            FPR[(fd & ~1) + 1] = (uint)(value >> 32);
+        }
+        double GetD(int fs) => BitConverter.Int64BitsToDouble((long)GetPair(fs));
+        void SetD(int fd, double value) => SetPair(fd, (ulong)BitConverter.DoubleToInt64Bits(value));
+
+        //Rounds to an integer with the rounding mode of FCR31.
+        double Round(double value)
+        {
+            switch (FCR31 & 3)
+            {
+                case 0: return Math.Round(value, MidpointRounding.ToEven);
+                case 1: return Math.Truncate(value);
+                case 2: return Math.Ceiling(value);
+                default: return Math.Floor(value);
+            }
+        }
+
+        bool Condition
+        {
+            get { return (FCR31 & 0x800000) != 0; }
+            set { FCR31 = value ? FCR31 | 0x800000 : FCR31 & ~0x800000u; }
+        }
+
+        //Calls the function at address with up to four integer arguments and returns V0.
+        //Float arguments are passed in F12 and F14 by setting FPR before the call.
+        public long Call(uint address, uint stackPointer, long maxInstructions, params uint[] args)
+        {
+            for (int i = 0; i < args.Length; i++)
+                GPR[4 + i] = (int)args[i];
+            GPR[29] = (int)stackPointer;
+            GPR[31] = unchecked((int)ReturnAddress);
+            PC = address;
+            nextPC = address + 4;
+
+            var limit = Instructions + maxInstructions;
+            while (PC != ReturnAddress)
+            {
+                if (Instructions >= limit)
+                    throw new Exception($"R4300: call to {address.ToString("X8")} did not return within {maxInstructions} instructions");
+                Step();
+            }
+            return GPR[2];
+        }
+
+        void Branch(bool taken, uint pc, int offset, bool likely)
+        {
+            Branches++;
+            if (taken)
+                nextPC = (uint)(pc + 4 + (offset << 2));
+            else if (likely)
+            {
+                //Not taken branch likely: the delay slot is skipped.
+                PC = nextPC;
+                nextPC = PC + 4;
+            }
+        }
+
+        void Unsupported(uint instruction, uint pc)
+        {
+            throw new Exception($"R4300: unsupported instruction {instruction.ToString("X8")} at {pc.ToString("X8")}");
+        }
+
+        public void Step()
+        {
+            var pc = PC;
+            var instruction = Read32(pc);
+            PC = nextPC;
+            nextPC += 4;
+            Instructions++;
+
+            var op = instruction >> 26;
+            var rs = (int)(instruction >> 21) & 31;
+            var rt = (int)(instruction >> 16) & 31;
+            var rd = (int)(instruction >> 11) & 31;
+            var sa = (int)(instruction >> 6) & 31;
+            var funct = instruction & 63;
+            var imm = (short)instruction;
+            var address = (uint)(GPR[rs] + imm);
+
+            switch (op)
+            {
+                case 0: //SPECIAL
+                    switch (funct)
+                    {
+                        case 0: GPR[rd] = (int)((uint)GPR[rt] << sa); break; //SLL
+                        case 2: GPR[rd] = (int)((uint)GPR[rt] >> sa); break; //SRL
+                        case 3: GPR[rd] = (int)GPR[rt] >> sa; break; //SRA
+                        case 4: GPR[rd] = (int)((uint)GPR[rt] << (int)(GPR[rs] & 31)); break; //SLLV
+                        case 6: GPR[rd] = (int)((uint)GPR[rt] >> (int)(GPR[rs] & 31)); break; //SRLV
+                        case 7: GPR[rd] = (int)GPR[rt] >> (int)(GPR[rs] & 31); break; //SRAV
+                        case 8: Branches++; nextPC = (uint)GPR[rs]; break; //JR
+                        case 9: Branches++; nextPC = (uint)GPR[rs]; GPR[rd] = (int)(pc + 8); break; //JALR
+                        case 15: break; //SYNC
+                        case 16: GPR[rd] = HI; break; //MFHI
+                        case 17: HI = GPR[rs]; break; //MTHI
+                        case 18: GPR[rd] = LO; break; //MFLO
+                        case 19: LO = GPR[rs]; break; //MTLO
+                        case 20: GPR[rd] = GPR[rt] << (int)(GPR[rs] & 63); break; //DSLLV
+                        case 22: GPR[rd] = (long)((ulong)GPR[rt] >> (int)(GPR[rs] & 63)); break; //DSRLV
+                        case 23: GPR[rd] = GPR[rt] >> (int)(GPR[rs] & 63); break; //DSRAV
+                        case 24: //MULT
+                            {
+                                var product = (long)(int)GPR[rs] * (int)GPR[rt];
+                                LO = (int)product;
+                                HI = (int)(product >> 32);
+                                break;
+                            }
+                        case 25: //MULTU
+                            {
+                                var product = (ulong)(uint)GPR[rs] * (uint)GPR[rt];
+                                LO = (int)product;
+                                HI = (int)(product >> 32);
+                                break;
+                            }
+                        case 26: //DIV
+                            if ((int)GPR[rt] != 0 && !((int)GPR[rs] == int.MinValue && (int)GPR[rt] == -1))
+                            {
+                                LO = (int)GPR[rs] / (int)GPR[rt];
+                                HI = (int)GPR[rs] % (int)GPR[rt];
+                            }
+                            break;
+                        case 27: //DIVU
+                            if ((uint)GPR[rt] != 0)
+                            {
+                                LO = (int)((uint)GPR[rs] / (uint)GPR[rt]);
+                                HI = (int)((uint)GPR[rs] % (uint)GPR[rt]);
+                            }
+                            break;
+                        case 32: //ADD
+                        case 33: GPR[rd] = (int)(GPR[rs] + GPR[rt]); break; //ADDU
+                        case 34: //SUB
+                        case 35: GPR[rd] = (int)(GPR[rs] - GPR[rt]); break; //SUBU
+                        case 36: GPR[rd] = GPR[rs] & GPR[rt]; break; //AND
+                        case 37: GPR[rd] = GPR[rs] | GPR[rt]; break; //OR
+                        case 38: GPR[rd] = GPR[rs] ^ GPR[rt]; break; //XOR
+                        case 39: GPR[rd] = ~(GPR[rs] | GPR[rt]); break; //NOR
+                        case 42: GPR[rd] = GPR[rs] < GPR[rt] ? 1 : 0; break; //SLT
+                        case 43: GPR[rd] = (ulong)GPR[rs] < (ulong)GPR[rt] ? 1 : 0; break; //SLTU
+                        case 44: //DADD
+                        case 45: GPR[rd] = GPR[rs] + GPR[rt]; break; //DADDU
+                        case 46: //DSUB
+                        case 47: GPR[rd] = GPR[rs] - GPR[rt]; break; //DSUBU
+                        case 56: GPR[rd] = GPR[rt] << sa; break; //DSLL
+                        case 58: GPR[rd] = (long)((ulong)GPR[rt] >> sa); break; //DSRL
+                        case 59: GPR[rd] = GPR[rt] >> sa; break; //DSRA
+                        case 60: GPR[rd] = GPR[rt] << (sa + 32); break; //DSLL32
+                        case 62: GPR[rd] = (long)((ulong)GPR[rt] >> (sa + 32)); break; //DSRL32
+                        case 63: GPR[rd] = GPR[rt] >> (sa + 32); break; //DSRA32
+                        default: Unsupported(instruction, pc); break;
+                    }
+                    break;
+                case 1: //REGIMM
+                    {
+                        var taken = (rt & 1) == 0 ? GPR[rs] < 0 : GPR[rs] >= 0;
+                        if ((rt & 16) != 0) //BLTZAL, BGEZAL, BLTZALL, BGEZALL
+                            GPR[31] = (int)(pc + 8);
+                        if ((rt & ~19) != 0)
+                            Unsupported(instruction, pc);
+                        Branch(taken, pc, imm, (rt & 2) != 0);
+                        break;
+                    }
+                case 2: //J
+                case 3: //JAL
+                    Branches++;
+                    if (op == 3)
+                        GPR[31] = (int)(pc + 8);
+                    nextPC = ((pc + 4) & 0xF0000000) | ((instruction & 0x3FFFFFF) << 2);
+                    break;
+                case 4: Branch(GPR[rs] == GPR[rt], pc, imm, false); break; //BEQ
+                case 5: Branch(GPR[rs] != GPR[rt], pc, imm, false); break; //BNE
+                case 6: Branch(GPR[rs] <= 0, pc, imm, false); break; //BLEZ
+                case 7: Branch(GPR[rs] > 0, pc, imm, false); break; //BGTZ
+                case 8: //ADDI
+                case 9: GPR[rt] = (int)(GPR[rs] + imm); break; //ADDIU
+                case 10: GPR[rt] = GPR[rs] < imm ? 1 : 0; break; //SLTI
+                case 11: GPR[rt] = (ulong)GPR[rs] < (ulong)(long)imm ? 1 : 0; break; //SLTIU
+                case 12: GPR[rt] = GPR[rs] & (ushort)imm; break; //ANDI
+                case 13: GPR[rt] = GPR[rs] | (ushort)imm; break; //ORI
+                case 14: GPR[rt] = GPR[rs] ^ (ushort)imm; break; //XORI
+                case 15: GPR[rt] = imm << 16; break; //LUI
+                case 17: ExecuteCOP1(instruction, pc); break;
+                case 20: Branch(GPR[rs] == GPR[rt], pc, imm, true); break; //BEQL
+                case 21: Branch(GPR[rs] != GPR[rt], pc, imm, true); break; //BNEL
+                case 22: Branch(GPR[rs] <= 0, pc, imm, true); break; //BLEZL
+                case 23: Branch(GPR[rs] > 0, pc, imm, true); break; //BGTZL
+                case 24: //DADDI
+                case 25: GPR[rt] = GPR[rs] + imm; break; //DADDIU
+                case 32: Loads++; GPR[rt] = (sbyte)Read8(address); break; //LB
+                case 33: Loads++; GPR[rt] = (short)Read16(address); break; //LH
+                case 34: //LWL
+                    {
+                        Loads++;
+                        var shift = (int)(address & 3) * 8;
+                        var word = Read32(address & ~3u);
+                        var mask = 0xFFFFFFFFu << shift;
+                        GPR[rt] = (int)(((uint)GPR[rt] & ~mask) | (word << shift));
+                        break;
+                    }
+                case 35: Loads++; GPR[rt] = (int)Read32(address); break; //LW
+                case 36: Loads++; GPR[rt] = Read8(address); break; //LBU
+                case 37: Loads++; GPR[rt] = Read16(address); break; //LHU
+                case 38: //LWR
+                    {
+                        Loads++;
+                        var shift = (3 - (int)(address & 3)) * 8;
+                        var word = Read32(address & ~3u);
+                        var mask = 0xFFFFFFFFu >> shift;
+                        GPR[rt] = (int)(((uint)GPR[rt] & ~mask) | (word >> shift));
+                        break;
+                    }
+                case 39: Loads++; GPR[rt] = Read32(address); break; //LWU
+                case 40: Stores++; Write8(address, (byte)GPR[rt]); break; //SB
+                case 41: Stores++; Write16(address, (ushort)GPR[rt]); break; //SH
+                case 42: //SWL
+                    {
+                        Stores++;
+                        var shift = (int)(address & 3) * 8;
+                        var word = Read32(address & ~3u);
+                        var mask = 0xFFFFFFFFu >> shift;
+                        Write32(address & ~3u, (word & ~mask) | ((uint)GPR[rt] >> shift));
+                        break;
+                    }
+                case 43: Stores++; Write32(address, (uint)GPR[rt]); break; //SW
+                case 46: //SWR
+                    {
+                        Stores++;
+                        var shift = (3 - (int)(address & 3)) * 8;
+                        var word = Read32(address & ~3u);
+                        var mask = 0xFFFFFFFFu << shift;
+                        Write32(address & ~3u, (word & ~mask) | ((uint)GPR[rt] << shift));
+                        break;
+                    }
+                case 47: break; //CACHE
+                case 49: Loads++; FPR[rt] = Read32(address); break; //LWC1
+                case 53: Loads++; SetPair(rt, Read64(address)); break; //LDC1
+                case 55: Loads++; GPR[rt] = (long)Read64(address); break; //LD
+                case 57: Stores++; Write32(address, FPR[rt]); break; //SWC1
+                case 61: Stores++; Write64(address, GetPair(rt)); break; //SDC1
+                case 63: Stores++; Write64(address, (ulong)GPR[rt]); break; //SD
+                default: Unsupported(instruction, pc); break;
+            }
+            GPR[0] = 0;
+        }
+
+        void ExecuteCOP1(uint instruction, uint pc)
+        {
+            var fmt = (int)(instruction >> 21) & 31;
+            var ft = (int)(instruction >> 16) & 31;
+            var fs = (int)(instruction >> 11) & 31;
+            var fd = (int)(instruction >> 6) & 31;
+            var funct = instruction & 63;
+
+            switch (fmt)
+            {
+                case 0: GPR[ft] = (int)FPR[fs]; return; //MFC1
+                case 2: GPR[ft] = fs == 31 ? (int)FCR31 : 0; return; //CFC1
+                case 4: FPR[fs] = (uint)GPR[ft]; return; //MTC1
+                case 6: //CTC1
+                    if (fs == 31)
+                        FCR31 = (uint)GPR[ft];
+                    return;
+                case 8: //BC1F, BC1T, BC1FL, BC1TL
+                    Branch(Condition == ((ft & 1) != 0), pc, (short)instruction, (ft & 2) != 0);
+                    return;
+                case 16: //S
+                case 17: //D
+                    break;
+                case 20: //W
+                case 21: //L
+                    FPUOps++;
+                    {
+                        double value = fmt == 20 ? (int)FPR[fs] : (long)GetPair(fs);
+                        if (funct == 32)
+                            SetS(fd, (float)value); //CVT.S
+                        else if (funct == 33)
+                            SetD(fd, value); //CVT.D
+                        else
+                            Unsupported(instruction, pc);
+                    }
+                    return;
+                default:
+                    Unsupported(instruction, pc);
+                    return;
+            }
+
+            FPUOps++;
+            var isDouble = fmt == 17;
+            double a = isDouble ? GetD(fs) : GetS(fs);
+            double b = isDouble ? GetD(ft) : GetS(ft);
+            double result;
+
+            if (funct >= 48) //C.cond
+            {
+                var unordered = double.IsNaN(a) || double.IsNaN(b);
+                Condition = ((funct & 4) != 0 && !unordered && a < b) || ((funct & 2) != 0 && !unordered && a == b) || ((funct & 1) != 0 && unordered);
+                return;
+            }
+
+            switch (funct)
+            {
+                case 0: result = a + b; break; //ADD
+                case 1: result = a - b; break; //SUB
+                case 2: result = a * b; break; //MUL
+                case 3: FPUDivSqrt++; result = a / b; break; //DIV
+                case 4: FPUDivSqrt++; result = Math.Sqrt(a); break; //SQRT
+                case 5: result = Math.Abs(a); break; //ABS
+                case 6: result = a; break; //MOV
+                case 7: result = -a; break; //NEG
+                case 12: FPR[fd] = (uint)(int)Math.Round(a, MidpointRounding.ToEven); return; //ROUND.W
+                case 13: FPR[fd] = (uint)(int)Math.Truncate(a); return; //TRUNC.W
+                case 14: FPR[fd] = (uint)(int)Math.Ceiling(a); return; //CEIL.W
+                case 15: FPR[fd] = (uint)(int)Math.Floor(a); return; //FLOOR.W
+                case 32: SetS(fd, (float)a); return; //CVT.S
+                case 33: SetD(fd, a); return; //CVT.D
+                case 36: FPR[fd] = (uint)(int)Round(a); return; //CVT.W
+                case 37: SetPair(fd, (ulong)(long)Round(a)); return; //CVT.L
+                default: Unsupported(instruction, pc); return;
+            }
+
+            //Single precision results are rounded to single precision after every operation, like the FPU does.
+            if (isDouble)
+                SetD(fd, result);
+            else
+                SetS(fd, (float)result);
+        }
+    }
+}
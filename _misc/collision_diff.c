@@ -0,0 +1,639 @@
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sm64.h"
+#include "game/object_list_processor.h"
+#include "surface_collision.h"
+#include "surface_load.h"
+#include "collision_diff.h"
+
+// The vanilla wall routine here works on unscaled positions.
+#ifdef EXT_BOUNDARIES
+#error "The collision diff harness does not support EXT_BOUNDARIES"
+#endif
+
+// Probes generated, tested and binned together.
+#define PROBE_BLOCK_SIZE 256
+
+/**
+ * The level walls as vanilla partitions them: the fixed 16x16 cells with a 50 unit
+ * buffer, and the walls of each cell in load order. The walls of cell i are
+ * sVanillaWalls[sVanillaCellStart[i]..sVanillaCellStart[i + 1]-1].
+ */
+static s32 sVanillaCellStart[NUM_CELLS * NUM_CELLS + 1];
+static struct Surface **sVanillaWalls;
+static s16 sVanillaWallMinY, sVanillaWallMaxY;
+
+// Object surfaces of the patched queries, none.
+static SpatialPartitionCell sNoDynamicSurfaces[NUM_CELLS][NUM_CELLS];
+
+struct DiffWorker
+{
+    struct CollisionDiffConfig *config;
+    struct CollisionDiffBin *bins;
+    u32 *nextBlock;
+    u64 numDiffs;
+};
+
+static f64 get_seconds(void) {
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1.0e-9;
+}
+
+/**
+ * Vanilla's cell range of a coordinate range, with the 50 unit buffer.
+ */
+static void get_vanilla_cell_range(s16 min, s16 max, s32 *minCell, s32 *maxCell) {
+    s32 lo = min + LEVEL_BOUNDARY_MAX;
+    s32 hi = max + LEVEL_BOUNDARY_MAX;
+
+    if (lo < 0) {
+        lo = 0;
+    }
+    if (hi < 0) {
+        hi = 0;
+    }
+
+    *minCell = lo / CELL_SIZE - (lo % CELL_SIZE < 50);
+    *maxCell = hi / CELL_SIZE + (hi % CELL_SIZE > CELL_SIZE - 50);
+
+    if (*minCell < 0) {
+        *minCell = 0;
+    }
+    if (*maxCell > NUM_CELLS_INDEX) {
+        *maxCell = NUM_CELLS_INDEX;
+    }
+}
+
+/**
+ * Finds the cell range of one axis of a surface, axis 0 for x and 2 for z.
+ */
+static void get_vanilla_surface_cell_range(struct Surface *surf, s32 axis, s32 *minCell, s32 *maxCell) {
+    s16 min = surf->vertex1[axis];
+    s16 max = surf->vertex1[axis];
+
+    if (surf->vertex2[axis] < min) {
+        min = surf->vertex2[axis];
+    }
+    if (surf->vertex3[axis] < min) {
+        min = surf->vertex3[axis];
+    }
+    if (surf->vertex2[axis] > max) {
+        max = surf->vertex2[axis];
+    }
+    if (surf->vertex3[axis] > max) {
+        max = surf->vertex3[axis];
+    }
+
+    get_vanilla_cell_range(min, max, minCell, maxCell);
+}
+
+/**
+ * Finds the range of cells of a surface, returns FALSE for surfaces that aren't walls.
+ */
+static s32 get_vanilla_wall_cells(struct Surface *surf, s32 *minCellX, s32 *maxCellX,
+                                  s32 *minCellZ, s32 *maxCellZ) {
+    if (surf->normal.y > 0.01 || surf->normal.y < -0.01) {
+        return FALSE;
+    }
+
+    get_vanilla_surface_cell_range(surf, 0, minCellX, maxCellX);
+    get_vanilla_surface_cell_range(surf, 2, minCellZ, maxCellZ);
+    return TRUE;
+}
+
+/**
+ * Builds the vanilla wall lists from the level surfaces, counting the walls
+ * of every cell first and then filling them in load order.
+ */
+static s32 build_vanilla_walls(void) {
+    s32 count[NUM_CELLS * NUM_CELLS];
+    s32 minCellX, maxCellX, minCellZ, maxCellZ;
+    s32 cellX, cellZ;
+    s32 i;
+
+    memset(count, 0, sizeof(count));
+    sVanillaWallMinY = 0x7FFF;
+    sVanillaWallMaxY = -0x8000;
+
+    for (i = 0; i < gNumStaticSurfaces; i++) {
+        if (!get_vanilla_wall_cells(&sSurfacePool[i], &minCellX, &maxCellX, &minCellZ, &maxCellZ)) {
+            continue;
+        }
+        for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+            for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+                count[cellZ * NUM_CELLS + cellX]++;
+            }
+        }
+        if (sSurfacePool[i].lowerY < sVanillaWallMinY) {
+            sVanillaWallMinY = sSurfacePool[i].lowerY;
+        }
+        if (sSurfacePool[i].upperY > sVanillaWallMaxY) {
+            sVanillaWallMaxY = sSurfacePool[i].upperY;
+        }
+    }
+
+    // A level without walls is probed around y = 0, where neither routine should
+    // find a wall.
+    if (sVanillaWallMinY > sVanillaWallMaxY) {
+        sVanillaWallMinY = 0;
+        sVanillaWallMaxY = 0;
+    }
+
+    sVanillaCellStart[0] = 0;
+    for (i = 0; i < NUM_CELLS * NUM_CELLS; i++) {
+        sVanillaCellStart[i + 1] = sVanillaCellStart[i] + count[i];
+        count[i] = sVanillaCellStart[i];
+    }
+
+    free(sVanillaWalls);
+    sVanillaWalls = malloc((sVanillaCellStart[NUM_CELLS * NUM_CELLS] + 1) * sizeof(struct Surface *));
+    if (sVanillaWalls == NULL) {
+        return FALSE;
+    }
+
+    for (i = 0; i < gNumStaticSurfaces; i++) {
+        if (!get_vanilla_wall_cells(&sSurfacePool[i], &minCellX, &maxCellX, &minCellZ, &maxCellZ)) {
+            continue;
+        }
+        for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+            for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+                sVanillaWalls[count[cellZ * NUM_CELLS + cellX]++] = &sSurfacePool[i];
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * Vanilla's find_wall_collisions_from_list for the level walls of a cell. Walls are
+ * tested with the projection of the triangle onto the x or z axis and pushed from
+ * within the radius on both sides, and every push starts from the original position.
+ */
+static s32 find_vanilla_wall_collisions(struct CollisionQueryContext *ctx, struct WallCollisionData *data) {
+    struct Surface *surf;
+    f32 offset;
+    f32 radius = data->radius;
+    f32 x = data->x;
+    f32 y = data->y + data->offsetY;
+    f32 z = data->z;
+    f32 w1, w2, w3;
+    f32 y1, y2, y3;
+    f32 sign;
+    s16 cellX, cellZ;
+    s32 i, end;
+    s32 numCols = 0;
+
+    data->numWalls = 0;
+
+    if ((s16) x <= -LEVEL_BOUNDARY_MAX || (s16) x >= LEVEL_BOUNDARY_MAX) {
+        return 0;
+    }
+    if ((s16) z <= -LEVEL_BOUNDARY_MAX || (s16) z >= LEVEL_BOUNDARY_MAX) {
+        return 0;
+    }
+
+    cellX = (((s16) x + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
+    cellZ = (((s16) z + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
+    i = sVanillaCellStart[cellZ * NUM_CELLS + cellX];
+    end = sVanillaCellStart[cellZ * NUM_CELLS + cellX + 1];
+
+    // Max collision radius = 200
+    if (radius > 200.0f) {
+        radius = 200.0f;
+    }
+
+    for (; i < end; i++) {
+        surf = sVanillaWalls[i];
+
+        if (y < surf->lowerY || y > surf->upperY) {
+            continue;
+        }
+
+        offset = surf->normal.x * x + surf->normal.y * y + surf->normal.z * z + surf->originOffset;
+
+        if (offset < -radius || offset > radius) {
+            continue;
+        }
+
+        y1 = surf->vertex1[1];
+        y2 = surf->vertex2[1];
+        y3 = surf->vertex3[1];
+
+        if (surf->flags & SURFACE_FLAG_X_PROJECTION) {
+            w1 = -surf->vertex1[2];
+            w2 = -surf->vertex2[2];
+            w3 = -surf->vertex3[2];
+            sign = surf->normal.x > 0.0f ? 1.0f : -1.0f;
+
+            if (sign * ((y1 - y) * (w2 - w1) - (w1 - -z) * (y2 - y1)) > 0.0f
+                || sign * ((y2 - y) * (w3 - w2) - (w2 - -z) * (y3 - y2)) > 0.0f
+                || sign * ((y3 - y) * (w1 - w3) - (w3 - -z) * (y1 - y3)) > 0.0f) {
+                continue;
+            }
+        } else {
+            w1 = surf->vertex1[0];
+            w2 = surf->vertex2[0];
+            w3 = surf->vertex3[0];
+            sign = surf->normal.z > 0.0f ? 1.0f : -1.0f;
+
+            if (sign * ((y1 - y) * (w2 - w1) - (w1 - x) * (y2 - y1)) > 0.0f
+                || sign * ((y2 - y) * (w3 - w2) - (w2 - x) * (y3 - y2)) > 0.0f
+                || sign * ((y3 - y) * (w1 - w3) - (w3 - x) * (y1 - y3)) > 0.0f) {
+                continue;
+            }
+        }
+
+        if (ctx->checkingForCamera) {
+            if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
+                continue;
+            }
+        } else {
+            if (surf->type == SURFACE_CAMERA_BOUNDARY) {
+                continue;
+            }
+
+            if (surf->type == SURFACE_VANISH_CAP_WALLS && ctx->currentObject != NULL) {
+                if (ctx->currentObject->activeFlags & ACTIVE_FLAG_MOVE_THROUGH_GRATE) {
+                    continue;
+                }
+                if (ctx->currentObject == ctx->marioObject && (ctx->marioState->flags & MARIO_VANISH_CAP)) {
+                    continue;
+                }
+            }
+        }
+
+        data->x += surf->normal.x * (radius - offset);
+        data->z += surf->normal.z * (radius - offset);
+
+        if (data->numWalls < 4) {
+            data->walls[data->numWalls++] = surf;
+        }
+
+        numCols++;
+    }
+
+    return numCols;
+}
+
+/**
+ * Hashes a probe number and field, giving a value in [0, 1). Every probe only
+ * depends on its own number, so the loops generating and binning a block of probes
+ * can be vectorized, and the probes don't depend on the number of threads. The
+ * wall routines themselves run one probe at a time.
+ */
+static f32 probe_random(u32 seed, u32 probe, u32 field) {
+    u32 h = seed ^ (probe * 5 + field) * 0x9E3779B9u;
+
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+
+    return (h >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * Tests one block of probes with both routines and adds them to the worker's bins.
+ */
+static void run_probe_block(struct DiffWorker *worker, struct CollisionQueryContext *ctx, u32 first, s32 count) {
+    struct CollisionDiffConfig *config = worker->config;
+    f32 probeX[PROBE_BLOCK_SIZE], probeY[PROBE_BLOCK_SIZE], probeZ[PROBE_BLOCK_SIZE];
+    f32 probeRadius[PROBE_BLOCK_SIZE], probeOffsetY[PROBE_BLOCK_SIZE];
+    f32 delta[PROBE_BLOCK_SIZE];
+    s32 countDiff[PROBE_BLOCK_SIZE];
+    s32 bin[PROBE_BLOCK_SIZE];
+    struct WallCollisionData vanilla, patched;
+    struct CollisionDiffBin *b;
+    f32 minY = sVanillaWallMinY - config->maxOffsetY;
+    f32 rangeY = sVanillaWallMaxY - minY;
+    s32 binsPerAxis = config->binsPerAxis;
+    s32 i;
+
+    for (i = 0; i < count; i++) {
+        probeX[i] = (probe_random(config->seed, first + i, 0) * 2.0f - 1.0f) * LEVEL_BOUNDARY_MAX;
+        probeZ[i] = (probe_random(config->seed, first + i, 1) * 2.0f - 1.0f) * LEVEL_BOUNDARY_MAX;
+        probeY[i] = minY + probe_random(config->seed, first + i, 2) * rangeY;
+        probeRadius[i] = config->minRadius
+                         + probe_random(config->seed, first + i, 3) * (config->maxRadius - config->minRadius);
+        probeOffsetY[i] = config->minOffsetY
+                          + probe_random(config->seed, first + i, 4) * (config->maxOffsetY - config->minOffsetY);
+    }
+
+    for (i = 0; i < count; i++) {
+        vanilla.x = patched.x = probeX[i];
+        vanilla.y = patched.y = probeY[i];
+        vanilla.z = patched.z = probeZ[i];
+        vanilla.offsetY = patched.offsetY = probeOffsetY[i];
+        vanilla.radius = patched.radius = probeRadius[i];
+
+        countDiff[i] = (find_vanilla_wall_collisions(ctx, &vanilla) != 0)
+                       != (find_wall_collisions_ctx(ctx, &patched) != 0);
+        delta[i] = sqrtf((vanilla.x - patched.x) * (vanilla.x - patched.x)
+                         + (vanilla.z - patched.z) * (vanilla.z - patched.z));
+    }
+
+    for (i = 0; i < count; i++) {
+        bin[i] = (s32)((probeZ[i] + LEVEL_BOUNDARY_MAX) * binsPerAxis / (2 * LEVEL_BOUNDARY_MAX)) * binsPerAxis
+                 + (s32)((probeX[i] + LEVEL_BOUNDARY_MAX) * binsPerAxis / (2 * LEVEL_BOUNDARY_MAX));
+    }
+
+    for (i = 0; i < count; i++) {
+        b = &worker->bins[bin[i]];
+        b->numProbes++;
+        if (countDiff[i] || delta[i] > config->tolerance) {
+            b->numDiffs++;
+            b->numCountDiffs += countDiff[i];
+            if (delta[i] > b->maxDelta) {
+                b->maxDelta = delta[i];
+            }
+            worker->numDiffs++;
+        }
+    }
+}
+
+static void *run_diff_worker(void *arg) {
+    struct DiffWorker *worker = arg;
+    struct CollisionDiffConfig *config = worker->config;
+    u32 numBlocks = (config->numProbes + PROBE_BLOCK_SIZE - 1) / PROBE_BLOCK_SIZE;
+    struct CollisionQueryContext ctx;
+    u32 block;
+    u32 first;
+    s32 count;
+
+    init_collision_query_context(&ctx);
+    ctx.dynamicPartition = sNoDynamicSurfaces;
+
+    while ((block = __sync_fetch_and_add(worker->nextBlock, 1)) < numBlocks) {
+        first = block * PROBE_BLOCK_SIZE;
+        count = PROBE_BLOCK_SIZE;
+        if (config->numProbes - first < PROBE_BLOCK_SIZE) {
+            count = config->numProbes - first;
+        }
+        run_probe_block(worker, &ctx, first, count);
+    }
+
+    return NULL;
+}
+
+/**
+ * Runs config->numProbes probes on config->numThreads threads, including the calling
+ * one, over the loaded level and fills result with the binned differences. Returns
+ * FALSE if memory could not be allocated.
+ */
+s32 collision_diff_run(struct CollisionDiffConfig *config, struct CollisionDiffResult *result) {
+    struct DiffWorker workers[COLLISION_DIFF_MAX_THREADS];
+    pthread_t threads[COLLISION_DIFF_MAX_THREADS];
+    s32 started[COLLISION_DIFF_MAX_THREADS];
+    s32 numThreads = config->numThreads;
+    s32 numBins = config->binsPerAxis * config->binsPerAxis;
+    u32 nextBlock = 0;
+    f64 startTime = get_seconds();
+    s32 i, j;
+
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    if (numThreads > COLLISION_DIFF_MAX_THREADS) {
+        numThreads = COLLISION_DIFF_MAX_THREADS;
+    }
+
+    result->binsPerAxis = config->binsPerAxis;
+    result->numProbes = config->numProbes;
+    result->numDiffs = 0;
+    result->bins = calloc(numBins, sizeof(struct CollisionDiffBin));
+
+    if (result->bins == NULL || !build_vanilla_walls()) {
+        free(result->bins);
+        result->bins = NULL;
+        return FALSE;
+    }
+
+    for (i = 0; i < numThreads; i++) {
+        workers[i].config = config;
+        workers[i].nextBlock = &nextBlock;
+        workers[i].numDiffs = 0;
+        workers[i].bins = i == 0 ? result->bins : calloc(numBins, sizeof(struct CollisionDiffBin));
+        started[i] = FALSE;
+    }
+
+    // Threads that fail to start or allocate leave their blocks to the others.
+    for (i = 1; i < numThreads; i++) {
+        if (workers[i].bins != NULL) {
+            started[i] = pthread_create(&threads[i], NULL, run_diff_worker, &workers[i]) == 0;
+        }
+    }
+    run_diff_worker(&workers[0]);
+
+    result->numDiffs = workers[0].numDiffs;
+    for (i = 1; i < numThreads; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+
+            for (j = 0; j < numBins; j++) {
+                result->bins[j].numProbes += workers[i].bins[j].numProbes;
+                result->bins[j].numDiffs += workers[i].bins[j].numDiffs;
+                result->bins[j].numCountDiffs += workers[i].bins[j].numCountDiffs;
+                if (workers[i].bins[j].maxDelta > result->bins[j].maxDelta) {
+                    result->bins[j].maxDelta = workers[i].bins[j].maxDelta;
+                }
+            }
+            result->numDiffs += workers[i].numDiffs;
+        }
+        free(workers[i].bins);
+    }
+
+    result->seconds = get_seconds() - startTime;
+    return TRUE;
+}
+
+/**
+ * Checks if a point is under a ceiling with its corners moved by CEIL_MARGIN, the same
+ * test as the ceiling searches make.
+ */
+static s32 is_point_under_ceil_margin(struct Surface *surf, f32 x, f32 z) {
+    s16 *vertices[3];
+    f32 vx[3], vz[3];
+    s32 i, next;
+
+    vertices[0] = surf->vertex1;
+    vertices[1] = surf->vertex2;
+    vertices[2] = surf->vertex3;
+
+    for (i = 0; i < 3; i++) {
+        vx[i] = vertices[i][0];
+        vz[i] = vertices[i][2];
+        if (surf->type != SURFACE_HANGABLE) {
+            add_ceil_margin(&vx[i], &vz[i], vertices[(i + 1) % 3], vertices[(i + 2) % 3], CEIL_MARGIN);
+        }
+    }
+
+    for (i = 0; i < 3; i++) {
+        next = (i + 1) % 3;
+        if ((vz[i] - z) * (vx[next] - vx[i]) - (vx[i] - x) * (vz[next] - vz[i]) > 0) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * The lowest ceiling of the level over a point that find_ceil_ctx could return, found
+ * by testing every level ceiling. Returns CELL_HEIGHT_LIMIT if there is none.
+ */
+static f32 find_ceil_full_scan(f32 x, f32 y, f32 z) {
+    struct Surface *surf;
+    f32 height = CELL_HEIGHT_LIMIT;
+    f32 newHeight;
+    s32 i;
+
+    for (i = 0; i < gNumStaticSurfaces; i++) {
+        surf = &sSurfacePool[i];
+
+        if (surf->normal.y >= -0.01 || surf->type == SURFACE_CAMERA_BOUNDARY
+            || !is_point_under_ceil_margin(surf, x, z)) {
+            continue;
+        }
+
+        newHeight = -(x * surf->normal.x + surf->normal.z * z + surf->originOffset) / surf->normal.y;
+        if (y - (newHeight - -78.0f) > 0.0f) {
+            continue;
+        }
+        if (newHeight < height) {
+            height = newHeight;
+        }
+    }
+
+    return height;
+}
+
+/**
+ * Compares the ceiling searches, which stop early in their sorted lists, with a full
+ * scan over the level ceilings. The probes are placed within twice CEIL_MARGIN of the
+ * edges of random level ceilings and up to maxRadius below them, where a steep ceiling
+ * with its corners moved could be lower than its lowerY. Runs on the calling thread only.
+ * @return The number of probes where the ceiling heights differ
+ */
+u64 collision_diff_check_ceils(struct CollisionDiffConfig *config) {
+    struct CollisionQueryContext ctx;
+    struct Surface **ceils;
+    struct Surface *surf, *ceil;
+    s16 *v1, *v2;
+    f32 t, x, y, z, dx, dz, length, out;
+    s32 numCeils = 0;
+    s32 edge;
+    u64 numDiffs = 0;
+    u32 i;
+
+    ceils = malloc((gNumStaticSurfaces + 1) * sizeof(struct Surface *));
+    if (ceils == NULL) {
+        return 0;
+    }
+
+    for (i = 0; i < (u32) gNumStaticSurfaces; i++) {
+        if (sSurfacePool[i].normal.y < -0.01) {
+            ceils[numCeils++] = &sSurfacePool[i];
+        }
+    }
+
+    init_collision_query_context(&ctx);
+    ctx.dynamicPartition = sNoDynamicSurfaces;
+
+    for (i = 0; i < config->numProbes && numCeils > 0; i++) {
+        surf = ceils[(u32)(probe_random(config->seed, i, 0) * numCeils)];
+        edge = (s32)(probe_random(config->seed, i, 1) * 3);
+        v1 = edge == 0 ? surf->vertex1 : edge == 1 ? surf->vertex2 : surf->vertex3;
+        v2 = edge == 0 ? surf->vertex2 : edge == 1 ? surf->vertex3 : surf->vertex1;
+
+        // A point on the edge, moved to either side of it.
+        t = probe_random(config->seed, i, 2);
+        dx = v2[0] - v1[0];
+        dz = v2[2] - v1[2];
+        length = sqrtf(dx * dx + dz * dz);
+        out = (probe_random(config->seed, i, 3) * 4.0f - 2.0f) * CEIL_MARGIN;
+        x = v1[0] + dx * t;
+        z = v1[2] + dz * t;
+        if (length > 0.0f) {
+            x += dz / length * out;
+            z -= dx / length * out;
+        }
+        y = v1[1] + (v2[1] - v1[1]) * t - 78.0f - probe_random(config->seed, i, 4) * config->maxRadius;
+
+        if (x <= -LEVEL_BOUNDARY_MAX || x >= LEVEL_BOUNDARY_MAX || z <= -LEVEL_BOUNDARY_MAX
+            || z >= LEVEL_BOUNDARY_MAX) {
+            continue;
+        }
+
+        if (find_ceil_ctx(&ctx, x, y, z, &ceil) != find_ceil_full_scan(x, y, z)) {
+            numDiffs++;
+        }
+    }
+
+    free(ceils);
+    return numDiffs;
+}
+
+/**
+ * Writes the share of differing probes of every bin as a grayscale image, +x to
+ * the right and +z down. Returns FALSE if the file could not be written.
+ */
+s32 collision_diff_write_pgm(struct CollisionDiffResult *result, const char *path) {
+    FILE *file = fopen(path, "wb");
+    struct CollisionDiffBin *b;
+    s32 i;
+
+    if (file == NULL) {
+        return FALSE;
+    }
+
+    fprintf(file, "P5\n%d %d\n255\n", result->binsPerAxis, result->binsPerAxis);
+    for (i = 0; i < result->binsPerAxis * result->binsPerAxis; i++) {
+        b = &result->bins[i];
+        fputc(b->numProbes != 0 ? (s32)(255.0f * b->numDiffs / b->numProbes + 0.5f) : 0, file);
+    }
+
+    return fclose(file) == 0;
+}
+
+/**
+ * Writes the bins with differences as CSV, with the level coordinates of their
+ * lower corner. Returns FALSE if the file could not be written.
+ */
+s32 collision_diff_write_csv(struct CollisionDiffResult *result, const char *path) {
+    FILE *file = fopen(path, "w");
+    struct CollisionDiffBin *b;
+    f32 binSize = 2.0f * LEVEL_BOUNDARY_MAX / result->binsPerAxis;
+    s32 binX, binZ;
+
+    if (file == NULL) {
+        return FALSE;
+    }
+
+    fprintf(file, "x,z,probes,diffs,count_diffs,max_delta\n");
+    for (binZ = 0; binZ < result->binsPerAxis; binZ++) {
+        for (binX = 0; binX < result->binsPerAxis; binX++) {
+            b = &result->bins[binZ * result->binsPerAxis + binX];
+            if (b->numDiffs != 0) {
+                fprintf(file, "%.0f,%.0f,%u,%u,%u,%.2f\n", binX * binSize - LEVEL_BOUNDARY_MAX,
+                        binZ * binSize - LEVEL_BOUNDARY_MAX, b->numProbes, b->numDiffs, b->numCountDiffs,
+                        b->maxDelta);
+            }
+        }
+    }
+
+    return fclose(file) == 0;
+}
+
+void collision_diff_free(struct CollisionDiffResult *result) {
+    free(result->bins);
+    result->bins = NULL;
+}
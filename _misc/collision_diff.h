@@ -0,0 +1,54 @@
+#ifndef COLLISION_DIFF_H
+#define COLLISION_DIFF_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+/**
+ * Host only. Compares the wall collisions of the loaded level against the vanilla
+ * wall routine (projection tests, backsides, pushes from the start position) over
+ * many random probes, and bins the probes where they disagree by position in the
+ * level. Only level geometry is compared, object walls are left out, and the
+ * collision code must be built without EXT_BOUNDARIES.
+ */
+
+#define COLLISION_DIFF_MAX_THREADS 64
+
+struct CollisionDiffConfig
+{
+    s32 numThreads;
+    u32 numProbes;
+    u32 seed;
+    f32 minRadius, maxRadius;
+    f32 minOffsetY, maxOffsetY;
+    // Pushes further apart than this count as a difference.
+    f32 tolerance;
+    // Heatmap resolution, the level's x and z range are split into this many bins.
+    s32 binsPerAxis;
+};
+
+struct CollisionDiffBin
+{
+    u32 numProbes;
+    u32 numDiffs;
+    u32 numCountDiffs; // differences in whether any wall was hit
+    f32 maxDelta;
+};
+
+struct CollisionDiffResult
+{
+    s32 binsPerAxis;
+    u64 numProbes;
+    u64 numDiffs;
+    f64 seconds;
+    struct CollisionDiffBin *bins; // binsPerAxis * binsPerAxis, z major
+};
+
+s32 collision_diff_run(struct CollisionDiffConfig *config, struct CollisionDiffResult *result);
+u64 collision_diff_check_ceils(struct CollisionDiffConfig *config);
+s32 collision_diff_write_pgm(struct CollisionDiffResult *result, const char *path);
+s32 collision_diff_write_csv(struct CollisionDiffResult *result, const char *path);
+void collision_diff_free(struct CollisionDiffResult *result);
+
+#endif // COLLISION_DIFF_H
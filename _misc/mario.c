@@ -532,6 +532,35 @@ void resolve_and_return_wall_collisions(Vec3f pos, f32 offset, f32 radius, struc
     pos[2] = collisionData->z;
 }
 
+/**
+ * Collides with walls using two spheres, like calling resolve_and_return_wall_collisions
+ * for the first and then the second sphere, but walking the wall lists only once.
+ * Returns the number of walls hit.
+ */
+s32 resolve_and_return_wall_collisions_pair(Vec3f pos, f32 offset1, f32 radius1, struct WallCollisionData *collisionData1,
+                                            f32 offset2, f32 radius2, struct WallCollisionData *collisionData2) {
+    struct WallCollisionData *spheres[2];
+    s32 numCollisions;
+
+    collisionData1->x = pos[0];
+    collisionData1->y = pos[1];
+    collisionData1->z = pos[2];
+    collisionData1->radius = radius1;
+    collisionData1->offsetY = offset1;
+    collisionData2->radius = radius2;
+    collisionData2->offsetY = offset2;
+
+    spheres[0] = collisionData1;
+    spheres[1] = collisionData2;
+    numCollisions = find_wall_collisions_multi(spheres, 2);
+
+    pos[0] = collisionData2->x;
+    pos[1] = collisionData2->y;
+    pos[2] = collisionData2->z;
+
+    return numCollisions;
+}
+
 /**
  * Finds the ceiling from a vec3f horizontally and a height (with 80 vertical buffer).
  */
@@ -1303,11 +1332,13 @@ void update_mario_joystick_inputs(struct MarioState *m) {
  * Resolves wall collisions, and updates a variety of inputs.
  */
 void update_mario_geometry_inputs(struct MarioState *m) {
+    struct WallCollisionData upperWall;
+    struct WallCollisionData lowerWall;
+    f32 waterLevel;
     f32 gasLevel;
     f32 ceilToFloorDist;
 
-    f32_find_wall_collision(&m->pos[0], &m->pos[1], &m->pos[2], 60.0f, 50.0f);
-    f32_find_wall_collision(&m->pos[0], &m->pos[1], &m->pos[2], 30.0f, 24.0f);
+    resolve_and_return_wall_collisions_pair(m->pos, 60.0f, 50.0f, &upperWall, 30.0f, 24.0f, &lowerWall);
 
     m->floorHeight = find_floor(m->pos[0], m->pos[1], m->pos[2], &m->floor);
 
@@ -1321,8 +1352,8 @@ void update_mario_geometry_inputs(struct MarioState *m) {
     }
 
     m->ceilHeight = vec3f_find_ceil(&m->pos[0], m->floorHeight, &m->ceil);
-    gasLevel = find_poison_gas_level(m->pos[0], m->pos[2]);
-    m->waterLevel = find_water_level(m->pos[0], m->pos[2]);
+    find_environment_levels(m->pos[0], m->pos[2], &waterLevel, &gasLevel);
+    m->waterLevel = waterLevel;
 
     if (m->floor != NULL) {
         m->floorAngle = atan2s(m->floor->normal.z, m->floor->normal.x);
@@ -29,6 +29,8 @@ void mario_set_forward_vel(struct MarioState *m, f32 speed);
 s32 mario_get_floor_class(struct MarioState *m);
 u32 mario_get_terrain_sound_addend(struct MarioState *m);
 void resolve_and_return_wall_collisions(Vec3f pos, f32 offset, f32 radius, struct WallCollisionData *collisionData);
+s32 resolve_and_return_wall_collisions_pair(Vec3f pos, f32 offset1, f32 radius1, struct WallCollisionData *collisionData1,
+                                            f32 offset2, f32 radius2, struct WallCollisionData *collisionData2);
 f32 vec3f_find_ceil(Vec3f pos, f32 height, struct Surface **ceil);
 s32 mario_facing_downhill(struct MarioState *m, s32 turnYaw);
 u32 mario_floor_is_slippery(struct MarioState *m);
@@ -59,6 +59,8 @@ s32 set_pole_position(struct MarioState *m, f32 offsetY) {
     UNUSED s32 unused1;
     UNUSED s32 unused2;
     UNUSED s32 unused3;
+    struct WallCollisionData upperWall;
+    struct WallCollisionData lowerWall;
     struct Surface *floor;
     struct Surface *ceil;
     f32 floorHeight;
@@ -76,16 +78,18 @@ s32 set_pole_position(struct MarioState *m, f32 offsetY) {
     m->pos[2] = m->usedObj->oPosZ;
     m->pos[1] = m->usedObj->oPosY + marioObj->oMarioPolePos + offsetY;
 
-    collided = f32_find_wall_collision(&m->pos[0], &m->pos[1], &m->pos[2], 60.0f, 50.0f);
-    collided |= f32_find_wall_collision(&m->pos[0], &m->pos[1], &m->pos[2], 30.0f, 24.0f);
+    collided = resolve_and_return_wall_collisions_pair(m->pos, 60.0f, 50.0f, &upperWall, 30.0f, 24.0f, &lowerWall);
 
-    ceilHeight = vec3f_find_ceil(m->pos, m->pos[1], &ceil);
+    floorHeight = find_floor_and_ceil(m->pos[0], m->pos[1], m->pos[2], m->pos[1] + 80.0f,
+                                      &floor, &ceil, &ceilHeight);
     if (m->pos[1] > ceilHeight - 160.0f) {
         m->pos[1] = ceilHeight - 160.0f;
         marioObj->oMarioPolePos = m->pos[1] - m->usedObj->oPosY;
+
+        // The floor has to be found again from the lowered position.
+        floorHeight = find_floor(m->pos[0], m->pos[1], m->pos[2], &floor);
     }
 
-    floorHeight = find_floor(m->pos[0], m->pos[1], m->pos[2], &floor);
     if (m->pos[1] < floorHeight) {
         m->pos[1] = floorHeight;
         set_mario_action(m, ACT_IDLE, 0);
@@ -310,8 +314,8 @@ s32 perform_hanging_step(struct MarioState *m, Vec3f nextPos) {
 	resolve_and_return_wall_collisions(nextPos, 50.0f, 50.0f, &wallCollisionData);
 	m->wall = wallCollisionData.numWalls == 0 ? NULL : wallCollisionData.walls[0];
 
-    floorHeight = find_floor(nextPos[0], nextPos[1], nextPos[2], &floor);
-    ceilHeight = vec3f_find_ceil(nextPos, floorHeight, &ceil);
+    floorHeight = find_floor_and_ceil(nextPos[0], nextPos[1], nextPos[2], FIND_CEIL_ABOVE_FLOOR,
+                                      &floor, &ceil, &ceilHeight);
 
     if (floor == NULL) {
         return HANG_HIT_CEIL_OR_OOB;
@@ -11,10 +11,38 @@
 
 static s16 sMovingSandSpeeds[] = { 12, 8, 4, 0 };
 
-struct Surface gWaterSurfacePseudoFloor = {
-	SURFACE_VERY_SLIPPERY, 0,    0,    0, 0, 0, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 },
-	{ 0.0f, 1.0f, 0.0f },  0.0f, NULL,
-};
+// Most air steps perform_air_step splits a frame into.
+#define AIR_STEP_MAX_STEPS 16
+// Farthest an air step may move without being able to pass through a wall or a floor.
+#define AIR_STEP_MAX_HORIZONTAL_DIST 50.0f
+#define AIR_STEP_MAX_VERTICAL_DIST   78.0f
+// Ground steps moving at most this far, with no wall hit on the last step, take one
+// or two quarter steps instead of four.
+#define GROUND_STEP_SINGLE_STEP_DIST 4.0f
+#define GROUND_STEP_DOUBLE_STEP_DIST 16.0f
+// Set in m->flags (in a bit vanilla leaves unused) when the last step was a ground step
+// whose wall checks found no walls. Air steps clear it.
+#define MARIO_GROUND_STEP_NO_WALLS 0x00000200
+
+#define WATER_SURFACE_PSEUDO_FLOOR_INIT {                                              \
+	SURFACE_VERY_SLIPPERY, 0,    0,    0, 0, 0, { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, \
+	{ 0.0f, 1.0f, 0.0f },  0.0f, NULL,                                                 \
+}
+
+struct Surface gWaterSurfacePseudoFloor = WATER_SURFACE_PSEUDO_FLOOR_INIT;
+
+#ifdef COLLISION_THREADS
+// The shell steps write the pseudo floor's origin offset, so every thread running
+// steps at once gets its own.
+static COLLISION_THREAD_LOCAL struct Surface sThreadWaterSurfacePseudoFloor = WATER_SURFACE_PSEUDO_FLOOR_INIT;
+#define WATER_SURFACE_PSEUDO_FLOOR (&sThreadWaterSurfacePseudoFloor)
+
+// Steps run on host worker threads have no audio to play sounds with.
+#undef play_sound
+#define play_sound(soundBits, pos) ((void) 0)
+#else
+#define WATER_SURFACE_PSEUDO_FLOOR (&gWaterSurfacePseudoFloor)
+#endif
 
 /**
  * Always returns zero. This may have been intended
@@ -88,7 +116,7 @@ BAD_RETURN(s32) init_bully_collision_data(struct BullyCollisionData *data, f32 p
 
 void mario_bonk_reflection(struct MarioState *m, u32 negateSpeed, struct Surface* wall) {
 	if (wall != NULL) {
-		s16 wallAngle = atan2s(wall->normal.z, wall->normal.x);
+		s16 wallAngle = SURFACE_WALL_YAW(wall);
 		m->faceAngle[1] = wallAngle - (s16)(m->faceAngle[1] - wallAngle);
 
 		play_sound((m->flags & MARIO_METAL_CAP) ? SOUND_ACTION_METAL_BONK : SOUND_ACTION_BONK,
@@ -276,11 +304,13 @@ static s32 perform_ground_quarter_step(struct MarioState *m, Vec3f nextPos) {
 	s32 oldWallDYaw;
 	s32 absWallDYaw;
 
-	resolve_and_return_wall_collisions(nextPos, 30.0f, 24.0f, &lowerWall);
-	resolve_and_return_wall_collisions(nextPos, 60.0f, 50.0f, &upperWall);
+	// Both wall checks count as touching a wall, not only the upper one kept in m->wall.
+	if (resolve_and_return_wall_collisions_pair(nextPos, 30.0f, 24.0f, &lowerWall, 60.0f, 50.0f, &upperWall) != 0) {
+		m->flags &= ~MARIO_GROUND_STEP_NO_WALLS;
+	}
 
-	floorHeight = find_floor(nextPos[0], nextPos[1], nextPos[2], &floor);
-	ceilHeight = vec3f_find_ceil(nextPos, floorHeight, &ceil);
+	floorHeight = find_floor_and_ceil(nextPos[0], nextPos[1], nextPos[2], FIND_CEIL_ABOVE_FLOOR,
+	                                  &floor, &ceil, &ceilHeight);
 
 	waterLevel = find_water_level(nextPos[0], nextPos[2]);
 
@@ -290,7 +320,7 @@ static s32 perform_ground_quarter_step(struct MarioState *m, Vec3f nextPos) {
 
 	if ((m->action & ACT_FLAG_RIDING_SHELL) && floorHeight < waterLevel) {
 		floorHeight = waterLevel;
-		floor = &gWaterSurfacePseudoFloor;
+		floor = WATER_SURFACE_PSEUDO_FLOOR;
 		floor->originOffset = floorHeight; //! Wrong origin offset (no effect)
 	}
 
@@ -314,14 +344,14 @@ static s32 perform_ground_quarter_step(struct MarioState *m, Vec3f nextPos) {
 	m->floorHeight = floorHeight;
 
 	if (m->wall != NULL) {
-		oldWallDYaw = atan2s(m->wall->normal.z, m->wall->normal.x) - m->faceAngle[1];
+		oldWallDYaw = SURFACE_WALL_YAW(m->wall) - m->faceAngle[1];
 		oldWallDYaw = oldWallDYaw < 0 ? -oldWallDYaw : oldWallDYaw;
 	}
 	else
 		oldWallDYaw = 0;
 
 	for (i = 0; i < upperWall.numWalls; i++) {
-		wallDYaw = atan2s(upperWall.walls[i]->normal.z, upperWall.walls[i]->normal.x) - m->faceAngle[1];
+		wallDYaw = SURFACE_WALL_YAW(upperWall.walls[i]) - m->faceAngle[1];
 		absWallDYaw = wallDYaw < 0 ? -wallDYaw : wallDYaw;
 		if (absWallDYaw > oldWallDYaw) {
 			oldWallDYaw = absWallDYaw;
@@ -342,16 +372,42 @@ static s32 perform_ground_quarter_step(struct MarioState *m, Vec3f nextPos) {
 }
 
 //This change has not been added to binary patches
+/**
+ * Picks how many quarter steps perform_ground_step takes. Short steps that follow a
+ * ground step whose wall checks found no walls are collapsed into one or two steps,
+ * the rest take four.
+ */
+static s32 get_ground_step_count(struct MarioState *m) {
+	f32 dist;
+
+	if (!(m->flags & MARIO_GROUND_STEP_NO_WALLS)) {
+		return 4;
+	}
+
+	dist = m->floor->normal.y * sqrtf(m->vel[0] * m->vel[0] + m->vel[2] * m->vel[2]);
+
+	if (dist <= GROUND_STEP_SINGLE_STEP_DIST) {
+		return 1;
+	}
+	if (dist <= GROUND_STEP_DOUBLE_STEP_DIST) {
+		return 2;
+	}
+	return 4;
+}
+
 s32 perform_ground_step(struct MarioState *m) {
 	s32 i;
 	u32 stepResult;
 	Vec3f intendedPos;
+	s32 numSteps = get_ground_step_count(m);
 
 	m->wall = NULL;
+	// Cleared by the quarter steps that find walls.
+	m->flags |= MARIO_GROUND_STEP_NO_WALLS;
 
-	for (i = 0; i < 4; i++) {
-		intendedPos[0] = m->pos[0] + m->floor->normal.y * (m->vel[0] / 4.0f);
-		intendedPos[2] = m->pos[2] + m->floor->normal.y * (m->vel[2] / 4.0f);
+	for (i = 0; i < numSteps; i++) {
+		intendedPos[0] = m->pos[0] + m->floor->normal.y * (m->vel[0] / numSteps);
+		intendedPos[2] = m->pos[2] + m->floor->normal.y * (m->vel[2] / numSteps);
 		intendedPos[1] = m->pos[1];
 
 		stepResult = perform_ground_quarter_step(m, intendedPos);
@@ -360,6 +416,13 @@ s32 perform_ground_step(struct MarioState *m) {
 		}
 	}
 
+	// Each quarter step queries two walls, a floor and a ceiling.
+	if (i == numSteps) {
+		gNumSkippedCalls.floor += 4 - numSteps;
+		gNumSkippedCalls.ceil += 4 - numSteps;
+		gNumSkippedCalls.wall += 2 * (4 - numSteps);
+	}
+
 	m->terrainSoundAddend = mario_get_terrain_sound_addend(m);
 	vec3f_copy(m->marioObj->header.gfx.pos, m->pos);
 	vec3s_set(m->marioObj->header.gfx.angle, 0, m->faceAngle[1], 0);
@@ -370,7 +433,71 @@ s32 perform_ground_step(struct MarioState *m) {
 	return stepResult;
 }
 
-struct Surface *check_ledge_grab(struct MarioState *m, struct Surface *grabbedWall, struct Surface *wall, Vec3f intendedPos, Vec3f nextPos, Vec3f ledgePos, struct Surface **ledgeFloor) {
+/**
+ * The floors found by the ledge probes of one air quarter step. All probes start at
+ * the same height, so only x and z tell them apart.
+ */
+struct LedgeProbeCache {
+	s16 numProbes;
+	f32 x[4];
+	f32 z[4];
+	f32 height[4];
+	struct Surface *floor[4];
+};
+
+/**
+ * Find the floor below a ledge probe, or reuse the one found by an earlier probe of
+ * this quarter step at the same position. Walls with the same normal, such as the
+ * two triangles of a quad, probe the same position.
+ */
+static f32 find_ledge_floor(struct LedgeProbeCache *probes, f32 x, f32 y, f32 z, struct Surface **pfloor) {
+	f32 height;
+	s16 i;
+
+	for (i = 0; i < probes->numProbes; i++) {
+		if (probes->x[i] == x && probes->z[i] == z) {
+			gNumSkippedCalls.floor++;
+			*pfloor = probes->floor[i];
+			return probes->height[i];
+		}
+	}
+
+	height = find_floor(x, y, z, pfloor);
+
+	if (probes->numProbes < 4) {
+		i = probes->numProbes++;
+		probes->x[i] = x;
+		probes->z[i] = z;
+		probes->height[i] = height;
+		probes->floor[i] = *pfloor;
+	}
+	return height;
+}
+
+/**
+ * Order the walls by how much Mario is moving into them, most first. Walls with the
+ * same score keep their order, so the wall check_ledge_grab settles on is the same
+ * as in list order, but once a ledge is found the walls after it rarely need a probe.
+ * As in vanilla, the ledge position is the one of the last probe made.
+ */
+static void sort_walls_by_facing(struct MarioState *m, struct WallCollisionData *walls, struct Surface **sorted) {
+	f32 scores[4];
+	f32 score;
+	s16 i;
+	s16 j;
+
+	for (i = 0; i < walls->numWalls; i++) {
+		score = walls->walls[i]->normal.x * m->vel[0] + walls->walls[i]->normal.z * m->vel[2];
+		for (j = i; j > 0 && scores[j - 1] > score; j--) {
+			scores[j] = scores[j - 1];
+			sorted[j] = sorted[j - 1];
+		}
+		scores[j] = score;
+		sorted[j] = walls->walls[i];
+	}
+}
+
+struct Surface *check_ledge_grab(struct MarioState *m, struct Surface *grabbedWall, struct Surface *wall, Vec3f intendedPos, Vec3f nextPos, Vec3f ledgePos, struct Surface **ledgeFloor, struct LedgeProbeCache *probes) {
 	f32 displacementX;
 	f32 displacementZ;
 
@@ -396,7 +523,7 @@ struct Surface *check_ledge_grab(struct MarioState *m, struct Surface *grabbedWa
 	// a higher ledge than expected (glitchy ledge grab)
 	ledgePos[0] = nextPos[0] - wall->normal.x * 60.0f;
 	ledgePos[2] = nextPos[2] - wall->normal.z * 60.0f;
-	ledgePos[1] = find_floor(ledgePos[0], nextPos[1] + 160.0f, ledgePos[2], ledgeFloor);
+	ledgePos[1] = find_ledge_floor(probes, ledgePos[0], nextPos[1] + 160.0f, ledgePos[2], ledgeFloor);
 
 	if (ledgePos[1] - nextPos[1] <= 100.0f) {
 		return grabbedWall;
@@ -413,7 +540,7 @@ s32 bonk_or_hit_lava_wall(struct MarioState *m, struct WallCollisionData *wallDa
 	result = AIR_STEP_NONE;
 
 	if (m->wall != NULL) {
-		oldWallDYaw = atan2s(m->wall->normal.z, m->wall->normal.x) - m->faceAngle[1];
+		oldWallDYaw = SURFACE_WALL_YAW(m->wall) - m->faceAngle[1];
 		oldWallDYaw = oldWallDYaw < 0 ? -oldWallDYaw : oldWallDYaw;
 	}
 	else
@@ -421,7 +548,7 @@ s32 bonk_or_hit_lava_wall(struct MarioState *m, struct WallCollisionData *wallDa
 
 	for (i = 0; i < wallData->numWalls; i++) {
 		if (wallData->walls[i] != NULL) {
-			wallDYaw = atan2s(wallData->walls[i]->normal.z, wallData->walls[i]->normal.x) - m->faceAngle[1];
+			wallDYaw = SURFACE_WALL_YAW(wallData->walls[i]) - m->faceAngle[1];
 			if (wallData->walls[i]->type == SURFACE_BURNING) {
 				m->wall = wallData->walls[i];
 				return AIR_STEP_HIT_LAVA_WALL;
@@ -466,11 +593,10 @@ s32 perform_air_quarter_step(struct MarioState *m, Vec3f intendedPos, u32 stepAr
 
 	vec3f_copy(nextPos, intendedPos);
 
-	resolve_and_return_wall_collisions(nextPos, 150.0f, 50.0f, &upperWall);
-	resolve_and_return_wall_collisions(nextPos, 30.0f, 50.0f, &lowerWall);
+	resolve_and_return_wall_collisions_pair(nextPos, 150.0f, 50.0f, &upperWall, 30.0f, 50.0f, &lowerWall);
 
-	floorHeight = find_floor(nextPos[0], nextPos[1], nextPos[2], &floor);
-	ceilHeight = vec3f_find_ceil(nextPos, floorHeight, &ceil);
+	floorHeight = find_floor_and_ceil(nextPos[0], nextPos[1], nextPos[2], FIND_CEIL_ABOVE_FLOOR,
+	                                  &floor, &ceil, &ceilHeight);
 
 	waterLevel = find_water_level(nextPos[0], nextPos[2]);
 
@@ -489,7 +615,7 @@ s32 perform_air_quarter_step(struct MarioState *m, Vec3f intendedPos, u32 stepAr
 
 	if ((m->action & ACT_FLAG_RIDING_SHELL) && floorHeight < waterLevel) {
 		floorHeight = waterLevel;
-		floor = &gWaterSurfacePseudoFloor;
+		floor = WATER_SURFACE_PSEUDO_FLOOR;
 		floor->originOffset = floorHeight; //! Incorrect origin offset (no effect)
 	}
 
@@ -536,8 +662,14 @@ s32 perform_air_quarter_step(struct MarioState *m, Vec3f intendedPos, u32 stepAr
 	// misalignment, you can activate these conditions in unexpected situations
 
 	if ((stepArg & AIR_STEP_CHECK_LEDGE_GRAB) && upperWall.numWalls == 0) {
+		struct Surface *ledgeWalls[4];
+		struct LedgeProbeCache ledgeProbes;
+
+		ledgeProbes.numProbes = 0;
+		sort_walls_by_facing(m, &lowerWall, ledgeWalls);
+
 		for (i = 0; i < lowerWall.numWalls; i++)
-			if ((grabbedWall = check_ledge_grab(m, grabbedWall, lowerWall.walls[i], intendedPos, nextPos, ledgePos, &ledgeFloor)))
+			if ((grabbedWall = check_ledge_grab(m, grabbedWall, ledgeWalls[i], intendedPos, nextPos, ledgePos, &ledgeFloor, &ledgeProbes)))
 				stepResult = AIR_STEP_GRABBED_LEDGE;
 		if (stepResult == AIR_STEP_GRABBED_LEDGE)
 		{
@@ -548,7 +680,7 @@ s32 perform_air_quarter_step(struct MarioState *m, Vec3f intendedPos, u32 stepAr
 			m->floorAngle = atan2s(ledgeFloor->normal.z, ledgeFloor->normal.x);
 
 			m->faceAngle[0] = 0;
-			m->faceAngle[1] = atan2s(grabbedWall->normal.z, grabbedWall->normal.x) + 0x8000;
+			m->faceAngle[1] = SURFACE_WALL_YAW(grabbedWall) + 0x8000;
 		}
 		else {
 			vec3f_copy(m->pos, nextPos);
@@ -685,17 +817,49 @@ void apply_vertical_wind(struct MarioState *m) {
 	}
 }
 
+/**
+ * Picks how many steps perform_air_step splits this frame's movement into. No step moves
+ * farther than the wall radius horizontally or the floor buffer vertically, up to
+ * AIR_STEP_MAX_STEPS. Away from walls a slow frame takes a single step, near walls
+ * at least four are taken so wall hits and ledge grabs behave like quarter steps.
+ */
+static s32 get_air_step_count(struct MarioState *m) {
+	f32 horizontalDist = sqrtf(m->vel[0] * m->vel[0] + m->vel[2] * m->vel[2]);
+	f32 verticalDist = m->vel[1] < 0.0f ? -m->vel[1] : m->vel[1];
+	f32 minY, maxY;
+	s32 numSteps = 1;
+
+	while (numSteps < AIR_STEP_MAX_STEPS
+		   && (horizontalDist > AIR_STEP_MAX_HORIZONTAL_DIST * numSteps
+			   || verticalDist > AIR_STEP_MAX_VERTICAL_DIST * numSteps)) {
+		numSteps++;
+	}
+
+	if (numSteps < 4) {
+		// The wall checks reach from 30 to 150 units above Mario.
+		minY = (m->vel[1] < 0.0f ? m->pos[1] + m->vel[1] : m->pos[1]) + 30.0f;
+		maxY = (m->vel[1] < 0.0f ? m->pos[1] : m->pos[1] + m->vel[1]) + 150.0f;
+
+		if (find_walls_in_cells(m->pos[0], m->pos[2], m->pos[0] + m->vel[0], m->pos[2] + m->vel[2], minY, maxY)) {
+			numSteps = 4;
+		}
+	}
+
+	return numSteps;
+}
+
 s32 perform_air_step(struct MarioState *m, u32 stepArg) {
 	//s16 wallDYaw;
 	Vec3f intendedPos;
-	const f32 numSteps = 4.0f; /* max(4.0f, (s32)(sqrtf(m->vel[0] * m->vel[0] + m->vel[1] * m->vel[1] + m->vel[2] * m->vel[2]) / 50.0f));*/
+	s32 numSteps = get_air_step_count(m);
 	s32 i;
 	s32 quarterStepResult;
 	s32 stepResult = AIR_STEP_NONE;
 
 	m->wall = NULL;
+	m->flags &= ~MARIO_GROUND_STEP_NO_WALLS;
 
-	for (i = 0; i < 4; i++) {
+	for (i = 0; i < numSteps; i++) {
 		intendedPos[0] = m->pos[0] + m->vel[0] / numSteps;
 		intendedPos[1] = m->pos[1] + m->vel[1] / numSteps;
 		intendedPos[2] = m->pos[2] + m->vel[2] / numSteps;
@@ -728,7 +892,7 @@ s32 perform_air_step(struct MarioState *m, u32 stepArg) {
 	vec3s_set(m->marioObj->header.gfx.angle, 0, m->faceAngle[1], 0);
 
 	/*if (stepResult == AIR_STEP_HIT_WALL && m->wall != NULL) {
-			wallDYaw = atan2s(m->wall->normal.z, m->wall->normal.x) - m->faceAngle[1];
+			wallDYaw = SURFACE_WALL_YAW(m->wall) - m->faceAngle[1];
 			if ((stepArg & AIR_STEP_CHECK_BONK) && (wallDYaw < -0x6000 || wallDYaw > 0x6000))
 			{
 				if (m->forwardVel > 16.0f)
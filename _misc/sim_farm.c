@@ -0,0 +1,275 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sm64.h"
+#include "surface_collision.h"
+#include "mario_step.h"
+#include "sim_farm.h"
+
+#ifndef COLLISION_THREADS
+#error "The sim farm needs the collision code built with COLLISION_THREADS"
+#endif
+
+/**
+ * The batches of trials a worker has left, batch numbers top..bottom-1. The owner
+ * takes batches from the bottom, other workers steal them from the top. No batches
+ * are added once the farm runs, so a worker that finds every queue empty is done.
+ */
+struct SimQueue
+{
+    pthread_mutex_t lock;
+    s32 top;
+    s32 bottom;
+};
+
+struct SimFarm
+{
+    struct SimFarmConfig *config;
+    struct SimTrial *trials;
+    s32 numTrials;
+    s32 numThreads;
+    struct SimQueue queues[SIM_FARM_MAX_THREADS];
+};
+
+struct SimWorker
+{
+    struct SimFarm *farm;
+    s32 index;
+    struct SimWorkerStats stats;
+    struct MarioState marioState;
+    struct Object marioObj;
+    struct MarioBodyState marioBodyState;
+    struct CollisionQueryContext ctx;
+};
+
+// Object partition of farms run without object surfaces.
+static SpatialPartitionCell sNoDynamicSurfaces[NUM_CELLS][NUM_CELLS];
+
+static f64 get_seconds(void) {
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1.0e-9;
+}
+
+/**
+ * Takes a batch from the bottom of a queue, or from the top if stealing.
+ * Returns -1 if the queue is empty.
+ */
+static s32 take_batch(struct SimQueue *queue, s32 steal) {
+    s32 batch = -1;
+
+    pthread_mutex_lock(&queue->lock);
+    if (queue->top < queue->bottom) {
+        batch = steal ? queue->top++ : --queue->bottom;
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    return batch;
+}
+
+/**
+ * Takes the next batch for a worker, from its own queue first. Returns -1 once
+ * every queue is empty.
+ */
+static s32 next_batch(struct SimWorker *worker) {
+    struct SimFarm *farm = worker->farm;
+    s32 batch = take_batch(&farm->queues[worker->index], FALSE);
+    s32 i;
+
+    for (i = 1; batch < 0 && i < farm->numThreads; i++) {
+        batch = take_batch(&farm->queues[(worker->index + i) % farm->numThreads], TRUE);
+        if (batch >= 0) {
+            worker->stats.numStolen++;
+        }
+    }
+
+    return batch;
+}
+
+/**
+ * Runs the steps of one trial from the start state set up from its seed.
+ */
+static void run_trial(struct SimWorker *worker, struct SimTrial *trial) {
+    struct SimFarmConfig *config = worker->farm->config;
+    struct MarioState *m = &worker->marioState;
+    s32 numSteps = config->numSteps;
+    s32 air;
+    s32 result;
+    s32 i;
+
+    memset(m, 0, sizeof(struct MarioState));
+    config->init_trial(m, trial->seed, config->arg);
+    m->marioObj = &worker->marioObj;
+    m->marioBodyState = &worker->marioBodyState;
+
+    worker->ctx.marioState = m;
+    worker->ctx.includeIntangible = FALSE;
+
+    trial->flags = 0;
+    trial->lastStepResult = 0;
+
+    m->floorHeight = find_floor(m->pos[0], m->pos[1], m->pos[2], &m->floor);
+    if (m->floor == NULL) {
+        trial->flags |= SIM_TRIAL_OUT_OF_BOUNDS;
+        numSteps = 0;
+    }
+
+    air = (m->action & ACT_FLAG_AIR) != 0;
+
+    for (i = 0; i < numSteps; i++) {
+        if (air) {
+            result = perform_air_step(m, config->stepArg);
+            if (result == AIR_STEP_LANDED) {
+                trial->flags |= SIM_TRIAL_LANDED;
+                air = FALSE;
+            } else if (result == AIR_STEP_HIT_WALL) {
+                trial->flags |= SIM_TRIAL_HIT_WALL;
+            }
+        } else {
+            result = perform_ground_step(m);
+            if (result == GROUND_STEP_LEFT_GROUND) {
+                trial->flags |= SIM_TRIAL_LEFT_GROUND;
+                air = TRUE;
+            } else if (result == GROUND_STEP_HIT_WALL) {
+                trial->flags |= SIM_TRIAL_HIT_WALL;
+            }
+        }
+        trial->lastStepResult = result;
+    }
+
+    trial->numSteps = i;
+    vec3f_copy(trial->endPos, m->pos);
+    vec3f_copy(trial->endVel, m->vel);
+
+    worker->stats.numTrials++;
+    worker->stats.numSteps += i;
+}
+
+static void *run_worker(void *arg) {
+    struct SimWorker *worker = arg;
+    struct SimFarm *farm = worker->farm;
+    f64 startTime = get_seconds();
+    s32 batch, i, end;
+
+    set_thread_collision_query_context(&worker->ctx);
+
+    while ((batch = next_batch(worker)) >= 0) {
+        end = (batch + 1) * SIM_FARM_BATCH_SIZE;
+        if (end > farm->numTrials) {
+            end = farm->numTrials;
+        }
+
+        for (i = batch * SIM_FARM_BATCH_SIZE; i < end; i++) {
+            run_trial(worker, &farm->trials[i]);
+        }
+    }
+
+    set_thread_collision_query_context(NULL);
+
+    worker->stats.seconds = get_seconds() - startTime;
+    return NULL;
+}
+
+/**
+ * Runs every trial, with the steps and setup of config, on config->numThreads
+ * threads including the calling one. The results are written to the trials, and
+ * the time and number of steps of each worker to stats, which may be NULL.
+ * Returns the number of threads used, or -1 if the workers could not be allocated.
+ */
+s32 sim_farm_run(struct SimFarmConfig *config, struct SimTrial *trials, s32 numTrials,
+                 struct SimFarmStats *stats) {
+    struct SimFarm farm;
+    struct SimWorker *workers;
+    pthread_t threads[SIM_FARM_MAX_THREADS];
+    s32 started[SIM_FARM_MAX_THREADS];
+    s32 numBatches = (numTrials + SIM_FARM_BATCH_SIZE - 1) / SIM_FARM_BATCH_SIZE;
+    f64 startTime;
+    s32 i;
+
+    farm.config = config;
+    farm.trials = trials;
+    farm.numTrials = numTrials;
+    farm.numThreads = config->numThreads;
+    if (farm.numThreads < 1) {
+        farm.numThreads = 1;
+    }
+    if (farm.numThreads > SIM_FARM_MAX_THREADS) {
+        farm.numThreads = SIM_FARM_MAX_THREADS;
+    }
+
+    workers = calloc(farm.numThreads, sizeof(struct SimWorker));
+    if (workers == NULL) {
+        return -1;
+    }
+
+    // Every worker starts with an even share of consecutive batches.
+    for (i = 0; i < farm.numThreads; i++) {
+        pthread_mutex_init(&farm.queues[i].lock, NULL);
+        farm.queues[i].top = (s32)((s64) numBatches * i / farm.numThreads);
+        farm.queues[i].bottom = (s32)((s64) numBatches * (i + 1) / farm.numThreads);
+
+        workers[i].farm = &farm;
+        workers[i].index = i;
+
+        init_collision_query_context(&workers[i].ctx);
+        workers[i].ctx.currentObject = &workers[i].marioObj;
+        workers[i].ctx.marioObject = &workers[i].marioObj;
+        workers[i].ctx.dynamicPartition =
+            config->dynamicSurfaces != NULL ? config->dynamicSurfaces : sNoDynamicSurfaces;
+    }
+
+    startTime = get_seconds();
+
+    // Threads that fail to start leave their batches to be stolen by the others.
+    for (i = 1; i < farm.numThreads; i++) {
+        started[i] = pthread_create(&threads[i], NULL, run_worker, &workers[i]) == 0;
+    }
+    run_worker(&workers[0]);
+    for (i = 1; i < farm.numThreads; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    if (stats != NULL) {
+        stats->numThreads = farm.numThreads;
+        stats->seconds = get_seconds() - startTime;
+        stats->numSteps = 0;
+        for (i = 0; i < farm.numThreads; i++) {
+            stats->workers[i] = workers[i].stats;
+            stats->numSteps += workers[i].stats.numSteps;
+        }
+    }
+
+    for (i = 0; i < farm.numThreads; i++) {
+        pthread_mutex_destroy(&farm.queues[i].lock);
+    }
+    free(workers);
+
+    return farm.numThreads;
+}
+
+/**
+ * Prints the steps per second of every worker and of the whole farm.
+ */
+void sim_farm_print_stats(struct SimFarmStats *stats) {
+    struct SimWorkerStats *worker;
+    s32 i;
+
+    for (i = 0; i < stats->numThreads; i++) {
+        worker = &stats->workers[i];
+        printf("worker %2d: %10llu trials %12llu steps %6llu stolen %12.0f steps/s\n", i,
+               (unsigned long long) worker->numTrials, (unsigned long long) worker->numSteps,
+               (unsigned long long) worker->numStolen,
+               worker->seconds > 0.0 ? worker->numSteps / worker->seconds : 0.0);
+    }
+
+    printf("%d threads: %llu steps in %.3f s, %.0f steps/s, %.0f steps/s per thread\n", stats->numThreads,
+           (unsigned long long) stats->numSteps, stats->seconds,
+           stats->seconds > 0.0 ? stats->numSteps / stats->seconds : 0.0,
+           stats->seconds > 0.0 ? stats->numSteps / stats->seconds / stats->numThreads : 0.0);
+}
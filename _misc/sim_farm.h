@@ -0,0 +1,72 @@
+#ifndef SIM_FARM_H
+#define SIM_FARM_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+#include "surface_collision.h"
+
+/**
+ * Host only. Runs many independent trials of Mario's air and ground steps on worker
+ * threads, for searching levels for places the collision lets Mario get stuck or
+ * fall through. The workers share the level geometry loaded by load_area_terrain
+ * and the object surfaces in the config, neither of which may change while the
+ * farm runs. Every worker has its own MarioState, Mario object and collision query
+ * context. The collision code must be built with COLLISION_THREADS.
+ */
+
+#define SIM_FARM_MAX_THREADS 64
+// Trials a worker takes from a queue at once.
+#define SIM_FARM_BATCH_SIZE  64
+
+// SimTrial flags
+#define SIM_TRIAL_OUT_OF_BOUNDS (1 << 0) // no floor under the start position
+#define SIM_TRIAL_LANDED        (1 << 1) // an air step landed
+#define SIM_TRIAL_LEFT_GROUND   (1 << 2) // a ground step left the ground
+#define SIM_TRIAL_HIT_WALL      (1 << 3) // a step hit a wall
+
+struct SimTrial
+{
+    u32 seed;
+    s16 flags;
+    s16 lastStepResult;
+    s32 numSteps; // steps run, less than the configured number when out of bounds
+    Vec3f endPos;
+    Vec3f endVel;
+};
+
+struct SimFarmConfig
+{
+    s32 numThreads;
+    s32 numSteps; // steps per trial
+    u32 stepArg;  // passed to perform_air_step
+    // Object surfaces all workers collide with, or NULL for none. Read by every
+    // worker at once, the workers never add or remove object surfaces.
+    SpatialPartitionCell (*dynamicSurfaces)[NUM_CELLS];
+    // Sets up the start state of a trial from its seed. Trials in the air (action
+    // with ACT_FLAG_AIR) start with air steps, the others with ground steps.
+    void (*init_trial)(struct MarioState *m, u32 seed, void *arg);
+    void *arg; // passed to init_trial, from several threads at once
+};
+
+struct SimWorkerStats
+{
+    u64 numTrials;
+    u64 numSteps;
+    u64 numStolen; // batches taken from the queues of other workers
+    f64 seconds;
+};
+
+struct SimFarmStats
+{
+    s32 numThreads;
+    f64 seconds;
+    u64 numSteps;
+    struct SimWorkerStats workers[SIM_FARM_MAX_THREADS];
+};
+
+s32 sim_farm_run(struct SimFarmConfig *config, struct SimTrial *trials, s32 numTrials,
+                 struct SimFarmStats *stats);
+void sim_farm_print_stats(struct SimFarmStats *stats);
+
+#endif // SIM_FARM_H
@@ -8,38 +8,403 @@
 #include "surface_collision.h"
 #include "surface_load.h"
 
+// Host builds cull the walls of the static arrays several at a time, except when
+// counting every wall tested.
+#if defined(SURFACE_SOA) && !defined(COLLISION_INSTRUMENTATION)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define WALL_CULL_LANES 8
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define WALL_CULL_LANES 4
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define WALL_CULL_LANES 4
+#endif
+#endif
+
+/**
+ * Finds the leaf cell of the static partition containing a position. The position
+ * is relative to the level's lower corner, in the range [0, 2 * LEVEL_BOUNDARY_MAX).
+ */
+static struct SurfaceNode *get_static_cell(s32 x, s32 z) {
+    struct StaticCell *cell = &gStaticCells[(z / CELL_SIZE) & NUM_CELLS_INDEX][(x / CELL_SIZE) & NUM_CELLS_INDEX];
+    s32 leafSize = CELL_SIZE >> cell->subdivision;
+    s32 leafX = (x % CELL_SIZE) / leafSize;
+    s32 leafZ = (z % CELL_SIZE) / leafSize;
+
+    return gStaticSurfacePartition[cell->firstLeaf + (leafZ << cell->subdivision) + leafX];
+}
+
+#ifdef SURFACE_SOA
+/**
+ * Returns the array ranges of a leaf cell of the static partition in a view.
+ */
+static struct SurfaceArrayRange *get_static_ranges(struct SurfaceNode *staticCell, s32 view) {
+    return gStaticSurfaceRanges[(SpatialPartitionCell *) staticCell - gStaticSurfacePartition][view];
+}
+#endif
+
+/**
+ * Returns the first node of a list of a cell in a view.
+ */
+static struct SurfaceNode *get_surface_list(struct SurfaceNode *cell, s32 listIndex, s32 view) {
+    return SURFACE_NODE_NEXT(&cell[listIndex], view);
+}
+
+/**
+ * Returns the wall list of a cell for the wall band containing a height.
+ */
+static s32 get_wall_list_index(s32 y) {
+    s32 band = (y - gWallBandBottom) >> gWallBandShift;
+
+    if (band < 0) {
+        band = 0;
+    }
+    if (band > NUM_WALL_BANDS - 1) {
+        band = NUM_WALL_BANDS - 1;
+    }
+
+    return SPATIAL_PARTITION_WALLS + band;
+}
+
 /**************************************************
- *                      WALLS                     *
+ *                  QUERY CONTEXT                 *
  **************************************************/
 
 /**
- * Iterate through the list of walls until all walls are checked and
- * have given their wall push.
+ * The context of the queries without one, loaded from the game's globals.
+ */
+static struct CollisionQueryContext sGameQueryContext;
+
+#ifdef COLLISION_THREADS
+/**
+ * The context used instead of sGameQueryContext by the queries of this thread.
+ */
+static COLLISION_THREAD_LOCAL struct CollisionQueryContext *sThreadQueryContext;
+
+/**
+ * Makes the queries without a context on this thread use ctx, or the game's
+ * globals again if ctx is NULL. The game code run by the thread, such as the
+ * steps, then only reads and writes ctx, and its counters stay in ctx.
+ */
+void set_thread_collision_query_context(struct CollisionQueryContext *ctx) {
+    sThreadQueryContext = ctx;
+}
+#endif
+
+/**
+ * Returns the view of the surfaces that a query collides with, picked once so the
+ * searches don't check every surface for the camera or vanish cap walls.
+ */
+static s32 get_surface_view(struct CollisionQueryContext *ctx) {
+    if (ctx->checkingForCamera) {
+        return SURFACE_VIEW_CAMERA;
+    }
+
+    if (ctx->currentObject != NULL) {
+        // If an object can pass through a vanish cap wall, pass through.
+        if (ctx->currentObject->activeFlags & ACTIVE_FLAG_MOVE_THROUGH_GRATE) {
+            return SURFACE_VIEW_THROUGH_VANISH_WALLS;
+        }
+
+        // If Mario has a vanish cap, pass through the vanish cap wall.
+        if (ctx->currentObject == ctx->marioObject && (ctx->marioState->flags & MARIO_VANISH_CAP)) {
+            return SURFACE_VIEW_THROUGH_VANISH_WALLS;
+        }
+    }
+
+    return SURFACE_VIEW_ACTORS;
+}
+
+/**
+ * Sets up a context for queries that don't come from the game: no camera or
+ * intangible floor checks, no current object, and the game's object surfaces.
+ * The floor hints it keeps are only valid for the terrain loaded when
+ * it was set up.
+ */
+void init_collision_query_context(struct CollisionQueryContext *ctx) {
+    s32 i;
+
+    ctx->checkingForCamera = FALSE;
+    ctx->includeIntangible = FALSE;
+    ctx->currentObject = NULL;
+    ctx->marioObject = NULL;
+    ctx->marioState = NULL;
+    ctx->dynamicPartition = gDynamicSurfacePartition;
+    ctx->numCalls.floor = 0;
+    ctx->numCalls.ceil = 0;
+    ctx->numCalls.wall = 0;
+    ctx->numFloorMisses = 0;
+    for (i = 0; i < NUM_FLOOR_HINTS; i++) {
+        ctx->floorHints[i].floor = NULL;
+    }
+}
+
+/**
+ * Loads the game's query inputs into sGameQueryContext.
+ */
+static struct CollisionQueryContext *begin_game_query(void) {
+    struct CollisionQueryContext *ctx = &sGameQueryContext;
+
+#ifdef COLLISION_THREADS
+    if (sThreadQueryContext != NULL) {
+        return sThreadQueryContext;
+    }
+#endif
+
+    ctx->checkingForCamera = gCheckingSurfaceCollisionsForCamera;
+    ctx->includeIntangible = gFindFloorIncludeSurfaceIntangible;
+    ctx->currentObject = gCurrentObject;
+    ctx->marioObject = gMarioObject;
+    ctx->marioState = gMarioState;
+    ctx->dynamicPartition = gDynamicSurfacePartition;
+
+    return ctx;
+}
+
+/**
+ * Moves the counters of sGameQueryContext to the debug trackers, and resets
+ * gFindFloorIncludeSurfaceIntangible after floor queries.
+ */
+static void end_game_query(struct CollisionQueryContext *ctx) {
+#ifdef COLLISION_THREADS
+    if (ctx == sThreadQueryContext) {
+        return;
+    }
+#endif
+
+    gFindFloorIncludeSurfaceIntangible = ctx->includeIntangible;
+
+    gNumCalls.floor += ctx->numCalls.floor;
+    gNumCalls.ceil += ctx->numCalls.ceil;
+    gNumCalls.wall += ctx->numCalls.wall;
+    gNumFindFloorMisses += ctx->numFloorMisses;
+
+    ctx->numCalls.floor = 0;
+    ctx->numCalls.ceil = 0;
+    ctx->numCalls.wall = 0;
+    ctx->numFloorMisses = 0;
+}
+
+/**************************************************
+ *                 INSTRUMENTATION                *
+ **************************************************/
+
+#ifdef COLLISION_INSTRUMENTATION
+#ifndef TARGET_N64
+#include <stdio.h>
+#endif
+
+u32 gSurfaceHitCounts[SURFACE_POOL_SIZE][NUM_SURFACE_COUNTS];
+
+/**
+ * Counts a level surface. Object surfaces are loaded again every frame, so
+ * their counts would mix different objects and they aren't counted. Queries
+ * on several threads share the counts, so they are added to atomically.
  */
+static void count_surface(struct Surface *surf, s32 counter) {
+    if (surf >= sSurfacePool && surf < sSurfacePool + gNumStaticSurfaces) {
+#ifdef COLLISION_THREADS
+        __atomic_fetch_add(&gSurfaceHitCounts[surf - sSurfacePool][counter], 1, __ATOMIC_RELAXED);
+#else
+        gSurfaceHitCounts[surf - sSurfacePool][counter]++;
+#endif
+    }
+}
+
+#define COUNT_SURFACE(surf, counter) count_surface(surf, counter)
+#else
+#define COUNT_SURFACE(surf, counter)
+#endif
+
+/**************************************************
+ *                      WALLS                     *
+ **************************************************/
 
 //#define EXT_BOUNDARIES
-static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode,
-                                          struct WallCollisionData *data) {
+// Factor the extended boundaries enlarge the level by, a power of two. Can be given by the build
+// (-DEXT_BOUNDARIES_SIZE=2.0f) to match a hack's boundary setting, the patcher detects it from the ROM.
+#ifndef EXT_BOUNDARIES_SIZE
+#define EXT_BOUNDARIES_SIZE 4.0f
+#endif
+
+#if WALL_ROUTINE_TIER == WALL_TIER_HYBRID
+#define IS_EDGE_ROUNDED(surf, edgeFlag) ((surf)->flags & (edgeFlag))
+#else
+#define IS_EDGE_ROUNDED(surf, edgeFlag) TRUE
+#endif
+
+/**
+ * Pushes a sphere out of a wall whose plane it is within the radius of. The face
+ * pushes along the normal, an edge pushes away from its closest point and widens
+ * the margin used for the edges of the walls after it. Which edges are rounded
+ * depends on WALL_ROUTINE_TIER. Returns TRUE if the wall counts as a collision.
+ */
+static s32 push_sphere_from_wall(struct Surface *surf, f32 offset, f32 *px, f32 y, f32 *pz, f32 radius,
+                                 f32 *pMarginRadius) {
+#if WALL_ROUTINE_TIER != WALL_TIER_FACE
 	const f32 corner_threshold = -0.9f;
+#endif
 
-    register struct Surface *surf;
-    register f32 offset;
-    register f32 radius = data->radius;
-    register f32 x = data->x;
-    register f32 y = data->y + data->offsetY;
-    register f32 z = data->z;
+	register f32 x = *px;
+	register f32 z = *pz;
 	register f32 v0x, v0y, v0z;
 	register f32 v1x, v1y, v1z;
 	register f32 v2x, v2y, v2z;
 	register f32 d00, d01, d11, d20, d21;
 	register f32 invDenom;
 	register f32 v, w;
-	register f32 margin_radius = radius - 1.0f;
+#if WALL_ROUTINE_TIER != WALL_TIER_FACE
+	register f32 marginSq;
+#endif
+
+	v0x = (f32)(surf->vertex2[0] - surf->vertex1[0]);
+	v0y = (f32)(surf->vertex2[1] - surf->vertex1[1]);
+	v0z = (f32)(surf->vertex2[2] - surf->vertex1[2]);
+
+	v1x = (f32)(surf->vertex3[0] - surf->vertex1[0]);
+	v1y = (f32)(surf->vertex3[1] - surf->vertex1[1]);
+	v1z = (f32)(surf->vertex3[2] - surf->vertex1[2]);
+
+	v2x = x - (f32)surf->vertex1[0];
+	v2y = y - (f32)surf->vertex1[1];
+	v2z = z - (f32)surf->vertex1[2];
+
+	//Face
+	d00 = v0x * v0x + v0y * v0y + v0z * v0z;
+	d01 = v0x * v1x + v0y * v1y + v0z * v1z;
+	d11 = v1x * v1x + v1y * v1y + v1z * v1z;
+	d20 = v2x * v0x + v2y * v0y + v2z * v0z;
+	d21 = v2x * v1x + v2y * v1y + v2z * v1z;
+	invDenom = 1.0f / (d00 * d11 - d01 * d01);
+	v = (d11 * d20 - d01 * d21) * invDenom;
+	if (v < 0.0f || v > 1.0f)
+		goto edge_1_2;
+
+	w = (d00 * d21 - d01 * d20) * invDenom;
+	if (w < 0.0f || w > 1.0f || v + w > 1.0f)
+		goto edge_1_2;
+
+	*px = x + surf->normal.x * (radius - offset);
+	*pz = z + surf->normal.z * (radius - offset);
+	return TRUE;
+
+edge_1_2:
+#if WALL_ROUTINE_TIER == WALL_TIER_FACE
+	return FALSE;
+#else
+	if (offset < 0)
+		return FALSE;
+	// Edges further away than this are rejected before taking the square root. The extra
+	// margin added to the square covers rounding, so the sqrtf test would reject them too.
+	marginSq = *pMarginRadius * *pMarginRadius + *pMarginRadius;
+	//Edge 1-2
+	if (v0y != 0.0f && IS_EDGE_ROUNDED(surf, SURFACE_FLAG_CONVEX_EDGE_1_2)) {
+		v = (v2y / v0y);
+		if (v < 0.0f || v > 1.0f)
+			goto edge_1_3;
+		d00 = v0x * v - v2x;
+		d01 = v0z * v - v2z;
+		invDenom = d00 * d00 + d01 * d01;
+		if (invDenom > marginSq)
+			goto edge_1_3;
+		invDenom = sqrtf(invDenom);
+		offset = invDenom - *pMarginRadius;
+		if (offset > 0.0f)
+			goto edge_1_3;
+		invDenom = offset / invDenom;
+		*px = x + (d00 *= invDenom);
+		*pz = z + (d01 *= invDenom);
+		*pMarginRadius += 0.01f;
+
+		if (d00 * surf->normal.x + d01 * surf->normal.z < corner_threshold * offset)
+			return FALSE;
+		else
+			return TRUE;
+	}
+
+edge_1_3:
+	//Edge 1-3
+	if (v1y != 0.0f && IS_EDGE_ROUNDED(surf, SURFACE_FLAG_CONVEX_EDGE_1_3)) {
+		v = (v2y / v1y);
+		if (v < 0.0f || v > 1.0f)
+			goto edge_2_3;
+		d00 = v1x * v - v2x;
+		d01 = v1z * v - v2z;
+		invDenom = d00 * d00 + d01 * d01;
+		if (invDenom > marginSq)
+			goto edge_2_3;
+		invDenom = sqrtf(invDenom);
+		offset = invDenom - *pMarginRadius;
+		if (offset > 0.0f)
+			goto edge_2_3;
+		invDenom = offset / invDenom;
+		*px = x + (d00 *= invDenom);
+		*pz = z + (d01 *= invDenom);
+		*pMarginRadius += 0.01f;
+
+		if (d00 * surf->normal.x + d01 * surf->normal.z < corner_threshold * offset)
+			return FALSE;
+		else
+			return TRUE;
+	}
+
+edge_2_3:
+	//Edge 2-3
+	v1x = (f32)(surf->vertex3[0] - surf->vertex2[0]);
+	v1y = (f32)(surf->vertex3[1] - surf->vertex2[1]);
+	v1z = (f32)(surf->vertex3[2] - surf->vertex2[2]);
+
+	v2x = x - (f32)surf->vertex2[0];
+	v2y = y - (f32)surf->vertex2[1];
+	v2z = z - (f32)surf->vertex2[2];
+
+	if (v1y != 0.0f && IS_EDGE_ROUNDED(surf, SURFACE_FLAG_CONVEX_EDGE_2_3)) {
+		v = (v2y / v1y);
+		if (v < 0.0f || v > 1.0f)
+			return FALSE;
+		d00 = v1x * v - v2x;
+		d01 = v1z * v - v2z;
+		invDenom = d00 * d00 + d01 * d01;
+		if (invDenom > marginSq)
+			return FALSE;
+		invDenom = sqrtf(invDenom);
+		offset = invDenom - *pMarginRadius;
+		if (offset > 0.0f)
+			return FALSE;
+		invDenom = offset / invDenom;
+		*px = x + (d00 *= invDenom);
+		*pz = z + (d01 *= invDenom);
+		*pMarginRadius += 0.01f;
+		if (d00 * surf->normal.x + d01 * surf->normal.z < corner_threshold * offset)
+			return FALSE;
+		else
+			return TRUE;
+	}
+	else
+		return FALSE;
+#endif
+}
+
+/**
+ * Iterate through the list of walls until all walls are checked and
+ * have given their wall push. The list is followed in the query's view.
+ */
+static s32 find_wall_collisions_from_list(struct CollisionQueryContext *ctx, struct SurfaceNode *surfaceNode,
+                                          struct WallCollisionData *data) {
+    register struct Surface *surf;
+    register f32 offset;
+    s32 view = get_surface_view(ctx);
+    register f32 radius = data->radius;
+    f32 x = data->x;
+    register f32 y = data->y + data->offsetY;
+    f32 z = data->z;
+	f32 margin_radius = radius - 1.0f;
 
 	s32 numCols = 0;
 
 #ifdef EXT_BOUNDARIES
-#define EXT_BOUNDARIES_SIZE 4.0f
 	const float down_scale = 1.0f / EXT_BOUNDARIES_SIZE;
 	radius *= down_scale;
 	x *= down_scale;
@@ -51,12 +416,19 @@ static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode,
     // Max collision radius = 200
     if (radius > 200.0f) {
         radius = 200.0f;
+        // The rounded edges don't reach past the clamped radius either, the leaf
+        // cells only keep walls that far out (see add_static_surface).
+        margin_radius = radius - 1.0f;
     }
 
     // Stay in this loop until out of walls.
     while (surfaceNode != NULL) {
         surf = surfaceNode->surface;
-        surfaceNode = surfaceNode->next;
+        surfaceNode = SURFACE_NODE_NEXT(surfaceNode, view);
+        if (SURFACE_CHAIN_SKIPS(surf, view)) {
+            continue;
+        }
+        COUNT_SURFACE(surf, SURFACE_COUNT_TESTED);
 
         // Exclude a large number of walls immediately to optimize.
         if (y < surf->lowerY || y > surf->upperY) {
@@ -68,147 +440,13 @@ static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode,
         if (offset < 0 || offset > radius) {
             continue;
         }
+        COUNT_SURFACE(surf, SURFACE_COUNT_PASSED);
 
-		// Determine if checking for the camera or not.
-		if (gCheckingSurfaceCollisionsForCamera) {
-			if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
-				continue;
-			}
-		}
-		else {
-			// Ignore camera only surfaces.
-			if (surf->type == SURFACE_CAMERA_BOUNDARY) {
-				continue;
-			}
-
-			// If an object can pass through a vanish cap wall, pass through.
-			if (surf->type == SURFACE_VANISH_CAP_WALLS) {
-				// If an object can pass through a vanish cap wall, pass through.
-				if (gCurrentObject != NULL
-					&& (gCurrentObject->activeFlags & ACTIVE_FLAG_MOVE_THROUGH_GRATE)) {
-					continue;
-				}
-
-				// If Mario has a vanish cap, pass through the vanish cap wall.
-				if (gCurrentObject != NULL && gCurrentObject == gMarioObject
-					&& (gMarioState->flags & MARIO_VANISH_CAP)) {
-					continue;
-				}
-			}
-		}
-
-		v0x = (f32)(surf->vertex2[0] - surf->vertex1[0]);
-		v0y = (f32)(surf->vertex2[1] - surf->vertex1[1]);
-		v0z = (f32)(surf->vertex2[2] - surf->vertex1[2]);
-
-		v1x = (f32)(surf->vertex3[0] - surf->vertex1[0]);
-		v1y = (f32)(surf->vertex3[1] - surf->vertex1[1]);
-		v1z = (f32)(surf->vertex3[2] - surf->vertex1[2]);
-
-		v2x = x - (f32)surf->vertex1[0];
-		v2y = y - (f32)surf->vertex1[1];
-		v2z = z - (f32)surf->vertex1[2];
-
-		//Face
-		d00 = v0x * v0x + v0y * v0y + v0z * v0z;
-		d01 = v0x * v1x + v0y * v1y + v0z * v1z;
-		d11 = v1x * v1x + v1y * v1y + v1z * v1z;
-		d20 = v2x * v0x + v2y * v0y + v2z * v0z;
-		d21 = v2x * v1x + v2y * v1y + v2z * v1z;
-		invDenom = 1.0f / (d00 * d11 - d01 * d01);
-		v = (d11 * d20 - d01 * d21) * invDenom;
-		if (v < 0.0f || v > 1.0f)
-			goto edge_1_2;
-
-		w = (d00 * d21 - d01 * d20) * invDenom;
-		if (w < 0.0f || w > 1.0f || v + w > 1.0f)
-			goto edge_1_2;
-
-		x += surf->normal.x * (radius - offset);
-		z += surf->normal.z * (radius - offset);
-		goto hasCollision;
-
-	edge_1_2:
-		if (offset < 0)
-			continue;
-		//Edge 1-2
-		if (v0y != 0.0f) {
-			v = (v2y / v0y);
-			if (v < 0.0f || v > 1.0f)
-				goto edge_1_3;
-			d00 = v0x * v - v2x;
-			d01 = v0z * v - v2z;
-			invDenom = sqrtf(d00 * d00 + d01 * d01);
-			offset = invDenom - margin_radius;
-			if (offset > 0.0f)
-				goto edge_1_3;
-			invDenom = offset / invDenom;
-			x += (d00 *= invDenom);
-			z += (d01 *= invDenom);
-			margin_radius += 0.01f;
-
-			if (d00 * surf->normal.x + d01 * surf->normal.z < corner_threshold * offset)
-				continue;
-			else
-				goto hasCollision;
-		}
-
-	edge_1_3:
-		//Edge 1-3
-		if (v1y != 0.0f) {
-			v = (v2y / v1y);
-			if (v < 0.0f || v > 1.0f)
-				goto edge_2_3;
-			d00 = v1x * v - v2x;
-			d01 = v1z * v - v2z;
-			invDenom = sqrtf(d00 * d00 + d01 * d01);
-			offset = invDenom - margin_radius;
-			if (offset > 0.0f)
-				goto edge_2_3;
-			invDenom = offset / invDenom;
-			x += (d00 *= invDenom);
-			z += (d01 *= invDenom);
-			margin_radius += 0.01f;
-
-			if (d00 * surf->normal.x + d01 * surf->normal.z < corner_threshold * offset)
-				continue;
-			else
-				goto hasCollision;
-		}
-
-	edge_2_3:
-		//Edge 2-3
-		v1x = (f32)(surf->vertex3[0] - surf->vertex2[0]);
-		v1y = (f32)(surf->vertex3[1] - surf->vertex2[1]);
-		v1z = (f32)(surf->vertex3[2] - surf->vertex2[2]);
-
-		v2x = x - (f32)surf->vertex2[0];
-		v2y = y - (f32)surf->vertex2[1];
-		v2z = z - (f32)surf->vertex2[2];
-
-		if (v1y != 0.0f) {
-			v = (v2y / v1y);
-			if (v < 0.0f || v > 1.0f)
-				continue;
-			d00 = v1x * v - v2x;
-			d01 = v1z * v - v2z;
-			invDenom = sqrtf(d00 * d00 + d01 * d01);
-			offset = invDenom - margin_radius;
-			if (offset > 0.0f)
-				continue;
-			invDenom = offset / invDenom;
-			x += (d00 *= invDenom);
-			z += (d01 *= invDenom);
-			margin_radius += 0.01f;
-			if (d00 * surf->normal.x + d01 * surf->normal.z < corner_threshold * offset)
-				continue;
-			else
-				goto hasCollision;
-		}
-		else
-			continue;
+        if (!push_sphere_from_wall(surf, offset, &x, y, &z, radius, &margin_radius)) {
+            continue;
+        }
+        COUNT_SURFACE(surf, SURFACE_COUNT_HIT);
 
-	hasCollision:
         //! (Unreferenced Walls) Since this only returns the first four walls,
         //  this can lead to wall interaction being missed. Typically unreferenced walls
         //  come from only using one wall, however.
@@ -231,6 +469,182 @@ static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode,
     return numCols;
 }
 
+#ifdef SURFACE_SOA
+/**
+ * Tests entry i of the static arrays like one wall of find_wall_collisions_from_list.
+ * Returns 1 if the wall counts as a collision.
+ */
+static s32 check_wall_array_entry(struct SurfaceArrays *arrays, s32 i, f32 *px, f32 y, f32 *pz, f32 radius,
+                                  f32 *pMarginRadius, struct WallCollisionData *data) {
+    struct Surface *surf;
+    f32 offset;
+
+    COUNT_SURFACE(arrays->surface[i], SURFACE_COUNT_TESTED);
+
+    if (y < arrays->lowerY[i] || y > arrays->upperY[i]) {
+        return 0;
+    }
+
+    offset = arrays->normalX[i] * *px + arrays->normalY[i] * y + arrays->normalZ[i] * *pz
+             + arrays->originOffset[i];
+
+    if (offset < 0 || offset > radius) {
+        return 0;
+    }
+
+    surf = arrays->surface[i];
+    COUNT_SURFACE(surf, SURFACE_COUNT_PASSED);
+
+    if (!push_sphere_from_wall(surf, offset, px, y, pz, radius, pMarginRadius)) {
+        return 0;
+    }
+    COUNT_SURFACE(surf, SURFACE_COUNT_HIT);
+
+    if (data->numWalls < 4) {
+        data->walls[data->numWalls++] = surf;
+    }
+
+    return 1;
+}
+
+#ifdef WALL_CULL_LANES
+// Widens the offset range of cull_wall_block, so that rounding differences
+// from the scalar test can only keep extra walls.
+#define WALL_CULL_SLACK 1.0f
+
+/**
+ * Does the height and offset checks of check_wall_array_entry for the
+ * WALL_CULL_LANES entries starting at i. Returns a mask of the entries left to
+ * test, which includes every entry these checks would not reject. The
+ * comparisons are negated so that NaN keeps an entry, like the scalar checks.
+ */
+static u32 cull_wall_block(struct SurfaceArrays *arrays, s32 i, f32 x, f32 y, f32 z, f32 radius) {
+#if defined(__AVX2__)
+    __m256 lowerY = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *) &arrays->lowerY[i])));
+    __m256 upperY = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *) &arrays->upperY[i])));
+    __m256 vy = _mm256_set1_ps(y);
+    __m256 offset = _mm256_add_ps(
+        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&arrays->normalX[i]), _mm256_set1_ps(x)),
+                                    _mm256_mul_ps(_mm256_loadu_ps(&arrays->normalY[i]), vy)),
+                      _mm256_mul_ps(_mm256_loadu_ps(&arrays->normalZ[i]), _mm256_set1_ps(z))),
+        _mm256_loadu_ps(&arrays->originOffset[i]));
+    __m256 keep = _mm256_and_ps(_mm256_cmp_ps(vy, lowerY, _CMP_NLT_UQ), _mm256_cmp_ps(vy, upperY, _CMP_NGT_UQ));
+
+    keep = _mm256_and_ps(keep, _mm256_cmp_ps(offset, _mm256_set1_ps(-WALL_CULL_SLACK), _CMP_NLT_UQ));
+    keep = _mm256_and_ps(keep, _mm256_cmp_ps(offset, _mm256_set1_ps(radius + WALL_CULL_SLACK), _CMP_NGT_UQ));
+    return _mm256_movemask_ps(keep);
+#elif defined(__SSE2__)
+    __m128i zero = _mm_setzero_si128();
+    __m128i lowerY16 = _mm_loadl_epi64((__m128i *) &arrays->lowerY[i]);
+    __m128i upperY16 = _mm_loadl_epi64((__m128i *) &arrays->upperY[i]);
+    __m128 lowerY = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(zero, lowerY16), 16));
+    __m128 upperY = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(zero, upperY16), 16));
+    __m128 vy = _mm_set1_ps(y);
+    __m128 offset = _mm_add_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&arrays->normalX[i]), _mm_set1_ps(x)),
+                              _mm_mul_ps(_mm_loadu_ps(&arrays->normalY[i]), vy)),
+                   _mm_mul_ps(_mm_loadu_ps(&arrays->normalZ[i]), _mm_set1_ps(z))),
+        _mm_loadu_ps(&arrays->originOffset[i]));
+    __m128 keep = _mm_and_ps(_mm_cmpnlt_ps(vy, lowerY), _mm_cmpngt_ps(vy, upperY));
+
+    keep = _mm_and_ps(keep, _mm_cmpnlt_ps(offset, _mm_set1_ps(-WALL_CULL_SLACK)));
+    keep = _mm_and_ps(keep, _mm_cmpngt_ps(offset, _mm_set1_ps(radius + WALL_CULL_SLACK)));
+    return _mm_movemask_ps(keep);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    static const u32 laneBits[4] = { 1, 2, 4, 8 };
+    float32x4_t lowerY = vcvtq_f32_s32(vmovl_s16(vld1_s16(&arrays->lowerY[i])));
+    float32x4_t upperY = vcvtq_f32_s32(vmovl_s16(vld1_s16(&arrays->upperY[i])));
+    float32x4_t vy = vdupq_n_f32(y);
+    float32x4_t offset = vaddq_f32(
+        vaddq_f32(vaddq_f32(vmulq_f32(vld1q_f32(&arrays->normalX[i]), vdupq_n_f32(x)),
+                            vmulq_f32(vld1q_f32(&arrays->normalY[i]), vy)),
+                  vmulq_f32(vld1q_f32(&arrays->normalZ[i]), vdupq_n_f32(z))),
+        vld1q_f32(&arrays->originOffset[i]));
+    uint32x4_t reject = vorrq_u32(vcltq_f32(vy, lowerY), vcgtq_f32(vy, upperY));
+
+    reject = vorrq_u32(reject, vcltq_f32(offset, vdupq_n_f32(-WALL_CULL_SLACK)));
+    reject = vorrq_u32(reject, vcgtq_f32(offset, vdupq_n_f32(radius + WALL_CULL_SLACK)));
+    return vaddvq_u32(vbicq_u32(vld1q_u32(laneBits), reject));
+#endif
+}
+#endif
+
+/**
+ * Same as find_wall_collisions_from_list, for a list of the static partition
+ * stored as arrays. With WALL_CULL_LANES, whole blocks of entries are culled
+ * first and only the entries left are tested. A push moves the sphere, so the
+ * rest of the block is culled again after one.
+ */
+static s32 find_wall_collisions_from_array(struct CollisionQueryContext *ctx, struct SurfaceArrayRange *range,
+                                           struct WallCollisionData *data) {
+    struct SurfaceArrays *arrays = &gStaticSurfaceArrays;
+    f32 radius = data->radius;
+    f32 x = data->x;
+    f32 y = data->y + data->offsetY;
+    f32 z = data->z;
+    f32 margin_radius = radius - 1.0f;
+    s32 i = range->start;
+    s32 end = range->start + range->count;
+#ifdef WALL_CULL_LANES
+    f32 prevX, prevZ;
+    u32 mask;
+    s32 lane;
+#endif
+
+    s32 numCols = 0;
+
+#ifdef EXT_BOUNDARIES
+    const float down_scale = 1.0f / EXT_BOUNDARIES_SIZE;
+    radius *= down_scale;
+    x *= down_scale;
+    y *= down_scale;
+    z *= down_scale;
+    margin_radius *= down_scale;
+#endif
+
+    // Max collision radius = 200
+    if (radius > 200.0f) {
+        radius = 200.0f;
+        // See find_wall_collisions_from_list.
+        margin_radius = radius - 1.0f;
+    }
+
+#ifdef WALL_CULL_LANES
+    for (; i + WALL_CULL_LANES <= end; i += WALL_CULL_LANES) {
+        mask = cull_wall_block(arrays, i, x, y, z, radius);
+
+        while (mask != 0) {
+            lane = __builtin_ctz(mask);
+            prevX = x;
+            prevZ = z;
+
+            numCols += check_wall_array_entry(arrays, i + lane, &x, y, &z, radius, &margin_radius, data);
+
+            // Keep only the later entries, culled again from the new position if the sphere moved.
+            if (x != prevX || z != prevZ) {
+                mask = cull_wall_block(arrays, i, x, y, z, radius);
+            }
+            mask &= ~((2u << lane) - 1);
+        }
+    }
+#endif
+
+    for (; i < end; i++) {
+        numCols += check_wall_array_entry(arrays, i, &x, y, &z, radius, &margin_radius, data);
+    }
+
+#ifdef EXT_BOUNDARIES
+    x *= EXT_BOUNDARIES_SIZE;
+    z *= EXT_BOUNDARIES_SIZE;
+#endif
+
+    data->x = x;
+    data->z = z;
+
+    return numCols;
+}
+#endif
+
 /**
  * Formats the position and wall search for find_wall_collisions.
  */
@@ -257,22 +671,21 @@ s32 f32_find_wall_collision(f32 *xPtr, f32 *yPtr, f32 *zPtr, f32 offsetY, f32 ra
 }
 
 /**
- * Find wall collisions and receive their push.
+ * Finds the object cell and the static leaf cell a wall collision sphere is in,
+ * and the wall list of its height band. Returns FALSE if the sphere is out of bounds.
  */
-s32 find_wall_collisions(struct WallCollisionData *colData) {
-    struct SurfaceNode *node;
+static s32 get_wall_collision_cells(SpatialPartitionCell (*dynamicPartition)[NUM_CELLS],
+                                    struct WallCollisionData *colData, struct SurfaceNode **dynamicCell,
+                                    struct SurfaceNode **staticCell, s32 *listIndex) {
     s16 cellX, cellZ;
-    s32 numCollisions = 0;
 	s16 x = colData->x;
 	s16 z = colData->z;
 
-    colData->numWalls = 0;
-
     if (x <= -LEVEL_BOUNDARY_MAX || x >= LEVEL_BOUNDARY_MAX) {
-        return numCollisions;
+        return FALSE;
     }
     if (z <= -LEVEL_BOUNDARY_MAX || z >= LEVEL_BOUNDARY_MAX) {
-        return numCollisions;
+        return FALSE;
     }
 
     // World (level) consists of a 16x16 grid. Find where the collision is on
@@ -280,93 +693,362 @@ s32 find_wall_collisions(struct WallCollisionData *colData) {
     cellX = ((x + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
     cellZ = ((z + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
 
+    *dynamicCell = dynamicPartition[cellZ][cellX];
+    *staticCell = get_static_cell(x + LEVEL_BOUNDARY_MAX, z + LEVEL_BOUNDARY_MAX);
+
+    // Only walls in the height band of the collision sphere can be hit.
+#ifdef EXT_BOUNDARIES
+    *listIndex = get_wall_list_index((colData->y + colData->offsetY) / EXT_BOUNDARIES_SIZE);
+#else
+    *listIndex = get_wall_list_index(colData->y + colData->offsetY);
+#endif
+
+    return TRUE;
+}
+
+/**
+ * Find wall collisions and receive their push.
+ */
+s32 find_wall_collisions_ctx(struct CollisionQueryContext *ctx, struct WallCollisionData *colData) {
+    struct SurfaceNode *dynamicCell, *staticCell;
+    s32 numCollisions = 0;
+    s32 listIndex;
+    s32 view = get_surface_view(ctx);
+
+    colData->numWalls = 0;
+
+    if (!get_wall_collision_cells(ctx->dynamicPartition, colData, &dynamicCell, &staticCell, &listIndex)) {
+        return numCollisions;
+    }
+
     // Check for surfaces belonging to objects.
-    node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS].next;
-    numCollisions += find_wall_collisions_from_list(node, colData);
+    numCollisions += find_wall_collisions_from_list(ctx, get_surface_list(dynamicCell, listIndex, view), colData);
 
     // Check for surfaces that are a part of level geometry.
-    node = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS].next;
-    numCollisions += find_wall_collisions_from_list(node, colData);
+#ifdef SURFACE_SOA
+    numCollisions += find_wall_collisions_from_array(ctx, &get_static_ranges(staticCell, view)[listIndex], colData);
+#else
+    numCollisions += find_wall_collisions_from_list(ctx, get_surface_list(staticCell, listIndex, view), colData);
+#endif
 
     // Increment the debug tracker.
-    gNumCalls.wall += 1;
+    ctx->numCalls.wall += 1;
 
     return numCollisions;
 }
 
-/**************************************************
- *                     CEILINGS                   *
- **************************************************/
+s32 find_wall_collisions(struct WallCollisionData *colData) {
+    struct CollisionQueryContext *ctx = begin_game_query();
+    s32 numCollisions = find_wall_collisions_ctx(ctx, colData);
 
-void add_ceil_margin(f32 *x, f32 *z, Vec3s target1, Vec3s target2, f32 margin) {
-	register f32 diff_x, diff_z, invDenom;
-	diff_x = target1[0] - *x + target2[0] - *x;
-	diff_z = target1[2] - *z + target2[2] - *z;
-	invDenom = margin / sqrtf(diff_x * diff_x + diff_z * diff_z);
-	*x += diff_x * invDenom;
-	*z += diff_z * invDenom;
+    end_game_query(ctx);
+    return numCollisions;
 }
+
 /**
- * Iterate through the list of ceilings and find the first ceiling over a given point.
+ * Runs find_wall_collisions for each sphere in order, every sphere starting where
+ * the previous one was pushed to.
  */
-static struct Surface *find_ceil_from_list(struct SurfaceNode *surfaceNode, f32 x, f32 y, f32 z, f32 *pheight) {
-    register struct Surface *surf;
-    f32 x1, z1, x2, z2, x3, z3;
-    struct Surface *ceil = NULL;
-	f32 newHeight;
-	const f32 margin = 1.5f;
-
-    ceil = NULL;
+static s32 find_wall_collisions_in_order(struct CollisionQueryContext *ctx, struct WallCollisionData **colData,
+                                         s32 numSpheres) {
+    s32 numCollisions = 0;
+    s32 i;
 
-    // Stay in this loop until out of ceilings.
-    while (surfaceNode != NULL) {
-        surf = surfaceNode->surface;
-        surfaceNode = surfaceNode->next;
+    for (i = 0; i < numSpheres; i++) {
+        if (i > 0) {
+            colData[i]->x = colData[i - 1]->x;
+            colData[i]->y = colData[i - 1]->y;
+            colData[i]->z = colData[i - 1]->z;
+        }
+        numCollisions += find_wall_collisions_ctx(ctx, colData[i]);
+    }
 
-        x1 = surf->vertex1[0];
-        z1 = surf->vertex1[2];
-		if (surf->type != SURFACE_HANGABLE)
-			add_ceil_margin(&x1, &z1, surf->vertex2, surf->vertex3, margin);
+    return numCollisions;
+}
 
-        z2 = surf->vertex2[2];
-        x2 = surf->vertex2[0];
-		if (surf->type != SURFACE_HANGABLE)
-			add_ceil_margin(&x2, &z2, surf->vertex3, surf->vertex1, margin);
+/**
+ * Copies the walls of a list in a view that overlap the height range minY..maxY
+ * into a chain of candidate nodes, linked in the same view. Returns the next free
+ * node, or NULL if there are too many walls.
+ */
+static struct SurfaceNode *collect_wall_candidates(struct SurfaceNode *surfaceNode, s32 view, f32 minY, f32 maxY,
+                                                   struct SurfaceNode *candidate, struct SurfaceNode *end,
+                                                   struct SurfaceNode **head) {
+    struct SurfaceNode **tail = head;
+    struct Surface *surf;
 
-        // Checking if point is in bounds of the triangle laterally.
-        if ((z1 - z) * (x2 - x1) - (x1 - x) * (z2 - z1) > 0) {
-            continue;
-        }
+    while (surfaceNode != NULL) {
+        surf = surfaceNode->surface;
+        surfaceNode = SURFACE_NODE_NEXT(surfaceNode, view);
 
-        // Slight optimization by checking these later.
-        x3 = surf->vertex3[0];
-        z3 = surf->vertex3[2];
-		if (surf->type != SURFACE_HANGABLE)
-			add_ceil_margin(&x3, &z3, surf->vertex1, surf->vertex2, margin);
-        if ((z2 - z) * (x3 - x2) - (x2 - x) * (z3 - z2) > 0) {
+        if (SURFACE_CHAIN_SKIPS(surf, view) || maxY < surf->lowerY || minY > surf->upperY) {
             continue;
         }
-        if ((z3 - z) * (x1 - x3) - (x3 - x) * (z1 - z3) > 0) {
-            continue;
+        if (candidate == end) {
+            return NULL;
         }
 
-        // Determine if checking for the camera or not.
-        if (gCheckingSurfaceCollisionsForCamera != 0) {
-            if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
-                continue;
-            }
-        }
-        // Ignore camera only surfaces.
-        else if (surf->type == SURFACE_CAMERA_BOUNDARY) {
-            continue;
-        }
+        candidate->surface = surf;
+        *tail = candidate;
+        tail = &SURFACE_NODE_NEXT(candidate, view);
+        candidate++;
+    }
 
-        {
+    *tail = NULL;
+    return candidate;
+}
+
+/**
+ * Find wall collisions for several spheres at once, for example the upper and lower
+ * spheres of a step. The result is the same as calling find_wall_collisions for each
+ * sphere in order with the position pushed by the previous spheres: colData[0] holds
+ * the start position, and the others receive the position from the sphere before them.
+ * The wall lists are walked only once, collecting the walls in the height range of all
+ * spheres, and each sphere is then tested against those walls.
+ */
+s32 find_wall_collisions_multi_ctx(struct CollisionQueryContext *ctx, struct WallCollisionData **colData,
+                                   s32 numSpheres) {
+    struct SurfaceNode *candidates = ctx->wallCandidates;
+    struct SurfaceNode *dynamicCandidates, *staticCandidates;
+    struct SurfaceNode *dynamicCell, *staticCell;
+    struct SurfaceNode *sphereDynamicCell, *sphereStaticCell;
+    struct SurfaceNode *nextCandidate;
+    s32 listIndex, sphereListIndex;
+    s32 numCollisions = 0;
+    s32 view = get_surface_view(ctx);
+    f32 minY, maxY, y;
+    s32 i;
+
+    if (!get_wall_collision_cells(ctx->dynamicPartition, colData[0], &dynamicCell, &staticCell, &listIndex)) {
+        return find_wall_collisions_in_order(ctx, colData, numSpheres);
+    }
+
+    // Spheres in different height bands use different lists.
+    minY = maxY = colData[0]->y + colData[0]->offsetY;
+    for (i = 1; i < numSpheres; i++) {
+        colData[i]->y = colData[0]->y;
+#ifdef EXT_BOUNDARIES
+        sphereListIndex = get_wall_list_index((colData[i]->y + colData[i]->offsetY) / EXT_BOUNDARIES_SIZE);
+#else
+        sphereListIndex = get_wall_list_index(colData[i]->y + colData[i]->offsetY);
+#endif
+        if (sphereListIndex != listIndex) {
+            return find_wall_collisions_in_order(ctx, colData, numSpheres);
+        }
+
+        y = colData[i]->y + colData[i]->offsetY;
+        if (y < minY) {
+            minY = y;
+        }
+        if (y > maxY) {
+            maxY = y;
+        }
+    }
+
+#ifdef EXT_BOUNDARIES
+    minY *= 1.0f / EXT_BOUNDARIES_SIZE;
+    maxY *= 1.0f / EXT_BOUNDARIES_SIZE;
+#endif
+
+    // Object walls and level walls are kept apart, so every sphere checks them in
+    // the same order as find_wall_collisions.
+    nextCandidate = collect_wall_candidates(get_surface_list(dynamicCell, listIndex, view), view, minY, maxY,
+                                            candidates, candidates + WALL_CANDIDATES_MAX, &dynamicCandidates);
+    if (nextCandidate != NULL) {
+        nextCandidate = collect_wall_candidates(get_surface_list(staticCell, listIndex, view), view, minY, maxY,
+                                                nextCandidate, candidates + WALL_CANDIDATES_MAX, &staticCandidates);
+    }
+    if (nextCandidate == NULL) {
+        return find_wall_collisions_in_order(ctx, colData, numSpheres);
+    }
+
+    for (i = 0; i < numSpheres; i++) {
+        if (i > 0) {
+            colData[i]->x = colData[i - 1]->x;
+            colData[i]->z = colData[i - 1]->z;
+
+            // A push into another cell needs that cell's walls.
+            if (!get_wall_collision_cells(ctx->dynamicPartition, colData[i], &sphereDynamicCell,
+                                          &sphereStaticCell, &sphereListIndex)
+                || sphereDynamicCell != dynamicCell || sphereStaticCell != staticCell) {
+                numCollisions += find_wall_collisions_ctx(ctx, colData[i]);
+                continue;
+            }
+        }
+
+        colData[i]->numWalls = 0;
+        numCollisions += find_wall_collisions_from_list(ctx, dynamicCandidates, colData[i]);
+        numCollisions += find_wall_collisions_from_list(ctx, staticCandidates, colData[i]);
+
+        // Increment the debug tracker.
+        ctx->numCalls.wall += 1;
+    }
+
+    return numCollisions;
+}
+
+s32 find_wall_collisions_multi(struct WallCollisionData **colData, s32 numSpheres) {
+    struct CollisionQueryContext *ctx = begin_game_query();
+    s32 numCollisions = find_wall_collisions_multi_ctx(ctx, colData, numSpheres);
+
+    end_game_query(ctx);
+    return numCollisions;
+}
+
+/**
+ * Checks if the cell containing a position has any walls that actors collide with, of
+ * objects or of the level, in the height range minY..maxY. Positions out of bounds
+ * count as having walls.
+ */
+static s32 find_walls_in_cell(f32 xPos, f32 zPos, f32 minY, f32 maxY) {
+    SpatialPartitionCell (*dynamicPartition)[NUM_CELLS] = gDynamicSurfacePartition;
+    struct WallCollisionData colData;
+    struct SurfaceNode *dynamicCell, *staticCell;
+    struct SurfaceNode *node;
+    s32 listIndex, lastListIndex;
+
+#ifdef COLLISION_THREADS
+    if (sThreadQueryContext != NULL) {
+        dynamicPartition = sThreadQueryContext->dynamicPartition;
+    }
+#endif
+
+    colData.x = xPos;
+    colData.y = maxY;
+    colData.z = zPos;
+    colData.offsetY = 0.0f;
+
+    if (!get_wall_collision_cells(dynamicPartition, &colData, &dynamicCell, &staticCell, &lastListIndex)) {
+        return TRUE;
+    }
+
+#ifdef EXT_BOUNDARIES
+    minY *= 1.0f / EXT_BOUNDARIES_SIZE;
+    maxY *= 1.0f / EXT_BOUNDARIES_SIZE;
+#endif
+
+    for (listIndex = get_wall_list_index(minY); listIndex <= lastListIndex; listIndex++) {
+        for (node = dynamicCell[listIndex].next; node != NULL; node = node->next) {
+            if (!SURFACE_CHAIN_SKIPS(node->surface, SURFACE_VIEW_ACTORS)
+                && node->surface->lowerY <= maxY && node->surface->upperY >= minY) {
+                return TRUE;
+            }
+        }
+        for (node = staticCell[listIndex].next; node != NULL; node = node->next) {
+            if (!SURFACE_CHAIN_SKIPS(node->surface, SURFACE_VIEW_ACTORS)
+                && node->surface->lowerY <= maxY && node->surface->upperY >= minY) {
+                return TRUE;
+            }
+        }
+    }
+
+    return FALSE;
+}
+
+/**
+ * Checks if the cells a move from (x1, z1) to (x2, z2) passes through have any walls
+ * that actors collide with in the height range minY..maxY, see find_walls_in_cell.
+ * A move shorter than the smallest leaf cell on both axes only touches leaf cells
+ * that hold a corner of its box, longer moves count as having walls.
+ */
+s32 find_walls_in_cells(f32 x1, f32 z1, f32 x2, f32 z2, f32 minY, f32 maxY) {
+    f32 minLeafSize = CELL_SIZE >> STATIC_CELL_MAX_SUBDIVISION;
+    f32 dx = x2 < x1 ? x1 - x2 : x2 - x1;
+    f32 dz = z2 < z1 ? z1 - z2 : z2 - z1;
+
+    if (dx >= minLeafSize || dz >= minLeafSize) {
+        return TRUE;
+    }
+
+    return find_walls_in_cell(x1, z1, minY, maxY) || find_walls_in_cell(x2, z2, minY, maxY)
+           || find_walls_in_cell(x1, z2, minY, maxY) || find_walls_in_cell(x2, z1, minY, maxY);
+}
+
+/**************************************************
+ *                     CEILINGS                   *
+ **************************************************/
+
+void add_ceil_margin(f32 *x, f32 *z, Vec3s target1, Vec3s target2, f32 margin) {
+	register f32 diff_x, diff_z, invDenom;
+	diff_x = target1[0] - *x + target2[0] - *x;
+	diff_z = target1[2] - *z + target2[2] - *z;
+	invDenom = margin / sqrtf(diff_x * diff_x + diff_z * diff_z);
+	*x += diff_x * invDenom;
+	*z += diff_z * invDenom;
+}
+/**
+ * Checks if a point is within the bounds of a ceiling laterally. The corners of ceilings
+ * other than hangable ones are moved by a small margin, see add_ceil_margin.
+ */
+static s32 is_point_under_ceil(struct Surface *surf, f32 x, f32 z) {
+    f32 x1, z1, x2, z2, x3, z3;
+	const f32 margin = CEIL_MARGIN;
+
+    x1 = surf->vertex1[0];
+    z1 = surf->vertex1[2];
+	if (surf->type != SURFACE_HANGABLE)
+		add_ceil_margin(&x1, &z1, surf->vertex2, surf->vertex3, margin);
+
+    z2 = surf->vertex2[2];
+    x2 = surf->vertex2[0];
+	if (surf->type != SURFACE_HANGABLE)
+		add_ceil_margin(&x2, &z2, surf->vertex3, surf->vertex1, margin);
+
+    // Checking if point is in bounds of the triangle laterally.
+    if ((z1 - z) * (x2 - x1) - (x1 - x) * (z2 - z1) > 0) {
+        return FALSE;
+    }
+
+    // Slight optimization by checking these later.
+    x3 = surf->vertex3[0];
+    z3 = surf->vertex3[2];
+	if (surf->type != SURFACE_HANGABLE)
+		add_ceil_margin(&x3, &z3, surf->vertex1, surf->vertex2, margin);
+    if ((z2 - z) * (x3 - x2) - (x2 - x) * (z3 - z2) > 0) {
+        return FALSE;
+    }
+    if ((z3 - z) * (x1 - x3) - (x3 - x) * (z1 - z3) > 0) {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * Iterate through the list of ceilings and find the lowest ceiling over a given point.
+ * The list is sorted by the lowest point of each ceiling within its margin, so the
+ * search stops once the remaining ceilings all start above the ceiling found so far.
+ * The list is followed in the query's view.
+ */
+static struct Surface *find_ceil_from_list(struct CollisionQueryContext *ctx, struct SurfaceNode *surfaceNode,
+                                           f32 x, f32 y, f32 z, f32 *pheight) {
+    register struct Surface *surf;
+    struct Surface *ceil = NULL;
+	f32 newHeight;
+    s32 view = get_surface_view(ctx);
+
+    // Stay in this loop until out of ceilings.
+    while (surfaceNode != NULL) {
+        surf = surfaceNode->surface;
+        surfaceNode = SURFACE_NODE_NEXT(surfaceNode, view);
+
+        if (ceil != NULL && SURFACE_CEIL_BOTTOM(surf) > *pheight) {
+            break;
+        }
+        if (SURFACE_CHAIN_SKIPS(surf, view)) {
+            continue;
+        }
+        COUNT_SURFACE(surf, SURFACE_COUNT_TESTED);
+
+        if (!is_point_under_ceil(surf, x, z)) {
+            continue;
+        }
+
+        {
             f32 nx = surf->normal.x;
             f32 ny = surf->normal.y;
             f32 nz = surf->normal.z;
             f32 oo = surf->originOffset;
-            f32 height;
 
             // If a wall, ignore it. Likely a remnant, should never occur.
             if (ny == 0.0f) {
@@ -383,10 +1065,10 @@ static struct Surface *find_ceil_from_list(struct SurfaceNode *surfaceNode, f32
             if (y - (newHeight - -78.0f) > 0.0f) {
                 continue;
             }
+            COUNT_SURFACE(surf, SURFACE_COUNT_PASSED);
 
-			if (ceil == NULL || newHeight < height) {
-				height = newHeight;
-				*pheight = height;
+			if (ceil == NULL || newHeight < *pheight) {
+				*pheight = newHeight;
 				ceil = surf;
 			}
         }
@@ -395,15 +1077,99 @@ static struct Surface *find_ceil_from_list(struct SurfaceNode *surfaceNode, f32
     return ceil;
 }
 
+#ifdef SURFACE_SOA
 /**
- * Find the lowest ceiling above a given position and return the height.
+ * Same as find_ceil_from_list, for a list of the static partition stored as arrays.
+ * The height checks only read the arrays, the surface is read for the ceilings left.
  */
-f32 find_ceil(f32 xPos, f32 yPos, f32 zPos, struct Surface **pceil) {
-    s16 cellZ, cellX;
+static struct Surface *find_ceil_from_array(struct CollisionQueryContext *ctx, struct SurfaceArrayRange *range,
+                                            f32 x, f32 y, f32 z, f32 *pheight) {
+    struct SurfaceArrays *arrays = &gStaticSurfaceArrays;
+    struct Surface *surf;
+    struct Surface *ceil = NULL;
+    f32 newHeight;
+    s32 i;
+    s32 end = range->start + range->count;
+
+    for (i = range->start; i < end; i++) {
+        if (ceil != NULL && arrays->lowerY[i] > *pheight) {
+            break;
+        }
+        COUNT_SURFACE(arrays->surface[i], SURFACE_COUNT_TESTED);
+
+        // If a wall, ignore it. Likely a remnant, should never occur.
+        if (arrays->normalY[i] == 0.0f) {
+            continue;
+        }
+
+        newHeight = -(x * arrays->normalX[i] + arrays->normalZ[i] * z + arrays->originOffset[i])
+                    / arrays->normalY[i];
+
+        if (y - (newHeight - -78.0f) > 0.0f) {
+            continue;
+        }
+        if (ceil != NULL && !(newHeight < *pheight)) {
+            continue;
+        }
+
+        surf = arrays->surface[i];
+
+        if (!is_point_under_ceil(surf, x, z)) {
+            continue;
+        }
+        COUNT_SURFACE(surf, SURFACE_COUNT_PASSED);
+
+        *pheight = newHeight;
+        ceil = surf;
+    }
+
+    return ceil;
+}
+#endif
+
+/**
+ * Find the lowest ceiling above a given position in an object cell and a static cell.
+ */
+static f32 find_ceil_in_cells(struct CollisionQueryContext *ctx, struct SurfaceNode *dynamicCell,
+                              struct SurfaceNode *staticCell, f32 xPos, f32 yPos, f32 zPos,
+                              struct Surface **pceil) {
     struct Surface *ceil, *dynamicCeil;
-    struct SurfaceNode *surfaceList;
     f32 height = CELL_HEIGHT_LIMIT;
     f32 dynamicHeight = CELL_HEIGHT_LIMIT;
+    s32 view = get_surface_view(ctx);
+
+    // Check for surfaces belonging to objects.
+    dynamicCeil = find_ceil_from_list(ctx, get_surface_list(dynamicCell, SPATIAL_PARTITION_CEILS, view),
+                                      xPos, yPos, zPos, &dynamicHeight);
+
+    // Check for surfaces that are a part of level geometry.
+#ifdef SURFACE_SOA
+    ceil = find_ceil_from_array(ctx, &get_static_ranges(staticCell, view)[SPATIAL_PARTITION_CEILS], xPos, yPos,
+                                zPos, &height);
+#else
+    ceil = find_ceil_from_list(ctx, get_surface_list(staticCell, SPATIAL_PARTITION_CEILS, view), xPos, yPos, zPos,
+                               &height);
+#endif
+
+    if (dynamicHeight < height) {
+        ceil = dynamicCeil;
+        height = dynamicHeight;
+    }
+
+    *pceil = ceil;
+    COUNT_SURFACE(ceil, SURFACE_COUNT_HIT);
+
+    // Increment the debug tracker.
+    ctx->numCalls.ceil += 1;
+
+    return height;
+}
+
+/**
+ * Find the lowest ceiling above a given position and return the height.
+ */
+f32 find_ceil_ctx(struct CollisionQueryContext *ctx, f32 xPos, f32 yPos, f32 zPos, struct Surface **pceil) {
+    s16 cellZ, cellX;
 
     //! (Parallel Universes) Because position is casted to an s16, reaching higher
     // float locations  can return ceilings despite them not existing there.
@@ -411,203 +1177,660 @@ f32 find_ceil(f32 xPos, f32 yPos, f32 zPos, struct Surface **pceil) {
     *pceil = NULL;
 
     if (xPos <= -LEVEL_BOUNDARY_MAX || xPos >= LEVEL_BOUNDARY_MAX) {
-        return height;
+        return CELL_HEIGHT_LIMIT;
     }
     if (zPos <= -LEVEL_BOUNDARY_MAX || zPos >= LEVEL_BOUNDARY_MAX) {
-        return height;
+        return CELL_HEIGHT_LIMIT;
     }
 
     // Each level is split into cells to limit load, find the appropriate cell.
     cellX = (((s32)xPos + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
     cellZ = (((s32)zPos + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
 
-    // Check for surfaces belonging to objects.
-    surfaceList = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS].next;
-    dynamicCeil = find_ceil_from_list(surfaceList, xPos, yPos, zPos, &dynamicHeight);
+    return find_ceil_in_cells(ctx, ctx->dynamicPartition[cellZ][cellX],
+                              get_static_cell((s32)xPos + LEVEL_BOUNDARY_MAX, (s32)zPos + LEVEL_BOUNDARY_MAX),
+                              xPos, yPos, zPos, pceil);
+}
 
-    // Check for surfaces that are a part of level geometry.
-    surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS].next;
-    ceil = find_ceil_from_list(surfaceList, xPos, yPos, zPos, &height);
+f32 find_ceil(f32 xPos, f32 yPos, f32 zPos, struct Surface **pceil) {
+    struct CollisionQueryContext *ctx = begin_game_query();
+    f32 height = find_ceil_ctx(ctx, xPos, yPos, zPos, pceil);
 
-    if (dynamicHeight < height) {
-        ceil = dynamicCeil;
-        height = dynamicHeight;
+    end_game_query(ctx);
+    return height;
+}
+
+/**************************************************
+ *                     FLOORS                     *
+ **************************************************/
+
+/**
+ * Find the height of the highest floor below an object.
+ */
+f32 unused_obj_find_floor_height(struct Object *obj) {
+    struct Surface *floor;
+    f32 floorHeight = find_floor(obj->oPosX, obj->oPosY, obj->oPosZ, &floor);
+    return floorHeight;
+}
+
+/**
+ * Basically a local variable that passes through floor geo info.
+ */
+struct FloorGeometry sFloorGeo;
+
+static u8 unused8038BE50[0x40];
+
+/**
+ * Debug tracker of the collision queries that steps skipped, next to gNumCalls.
+ */
+COLLISION_THREAD_LOCAL struct CollisionCallCounts gNumSkippedCalls;
+
+/**
+ * Forget the floor hints of the game's queries, called when new terrain is loaded.
+ */
+void clear_static_floor_cache(void) {
+    s32 i;
+
+    for (i = 0; i < NUM_FLOOR_HINTS; i++) {
+        sGameQueryContext.floorHints[i].floor = NULL;
+    }
+}
+
+/**
+ * Return the floor height underneath (xPos, yPos, zPos) and populate `floorGeo`
+ * with data about the floor's normal vector and origin offset. Also update
+ * sFloorGeo.
+ */
+f32 find_floor_height_and_data(f32 xPos, f32 yPos, f32 zPos, struct FloorGeometry **floorGeo) {
+    struct Surface *floor;
+    f32 floorHeight = find_floor(xPos, yPos, zPos, &floor);
+
+    *floorGeo = NULL;
+
+    if (floor != NULL) {
+        sFloorGeo.normalX = floor->normal.x;
+        sFloorGeo.normalY = floor->normal.y;
+        sFloorGeo.normalZ = floor->normal.z;
+        sFloorGeo.originOffset = floor->originOffset;
+
+        *floorGeo = &sFloorGeo;
+    }
+    return floorHeight;
+}
+
+/**
+ * Checks if a point is within the bounds of a floor laterally.
+ */
+static s32 is_point_over_floor(struct Surface *surf, f32 x, f32 z) {
+    register f32 x1, z1, x2, z2, x3, z3;
+
+    x1 = surf->vertex1[0];
+    z1 = surf->vertex1[2];
+    x2 = surf->vertex2[0];
+    z2 = surf->vertex2[2];
+
+    // Check that the point is within the triangle bounds.
+    if ((z1 - z) * (x2 - x1) - (x1 - x) * (z2 - z1) < 0) {
+        return FALSE;
+    }
+
+    // To slightly save on computation time, set this later.
+    x3 = surf->vertex3[0];
+    z3 = surf->vertex3[2];
+
+    if ((z2 - z) * (x3 - x2) - (x2 - x) * (z3 - z2) < 0) {
+        return FALSE;
+    }
+    if ((z3 - z) * (x1 - x3) - (x3 - x) * (z1 - z3) < 0) {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+// Floors a search keeps while they may still come within reach of the search under
+// an intangible floor, see struct FloorSearch.
+#define FLOOR_SEARCH_WINDOW 8
+
+/**
+ * The floors found by a search of one list. With resolveIntangible, the search also
+ * finds the floor that vanilla finds by searching again from 200 units under a
+ * SURFACE_INTANGIBLE floor (see find_static_floor): the highest floor passing the
+ * 78 unit buffer from there, the first in list order if several are as high. Floors
+ * too close under the highest floor so far wait in a window, as a higher floor found
+ * later can bring them into reach. If the window overflows, overflow is set and the
+ * floor under the intangible floor has to be searched for again.
+ */
+struct FloorSearch
+{
+    s16 resolveIntangible;
+    s16 floorFinal; // no floor left in the list can be higher
+    s16 overflow;
+    s16 numWaiting;
+    s32 numFloors; // floors that passed the checks, the list order of the next one
+    struct Surface *floor;
+    f32 height;
+    s32 floorOrder;
+    struct Surface *below;
+    f32 belowHeight;
+    s32 belowOrder;
+    struct Surface *waiting[FLOOR_SEARCH_WINDOW];
+    f32 waitingHeight[FLOOR_SEARCH_WINDOW];
+    s32 waitingOrder[FLOOR_SEARCH_WINDOW];
+};
+
+static void init_floor_search(struct FloorSearch *search, s32 resolveIntangible) {
+    search->resolveIntangible = resolveIntangible;
+    search->floorFinal = FALSE;
+    search->overflow = FALSE;
+    search->numWaiting = 0;
+    search->numFloors = 0;
+    search->floor = NULL;
+    search->below = NULL;
+}
+
+/**
+ * Checks if a floor at a height passes the 78 unit buffer of a search from 200
+ * units under a floor at intangibleHeight.
+ */
+static s32 is_floor_in_reach_under(f32 intangibleHeight, f32 height) {
+    f32 y = (f32)(intangibleHeight - 200.0f);
+
+    return !(y - (height + -78.0f) < 0.0f);
+}
+
+/**
+ * Makes a floor in reach under the highest floor the floor under it, if it is higher
+ * than the one so far or as high and earlier in the list.
+ */
+static void set_floor_below(struct FloorSearch *search, struct Surface *surf, f32 height, s32 order) {
+    if (search->below == NULL || height > search->belowHeight
+        || (height == search->belowHeight && order < search->belowOrder)) {
+        search->below = surf;
+        search->belowHeight = height;
+        search->belowOrder = order;
+    }
+}
+
+/**
+ * Keeps a floor out of reach under the highest floor, unless no higher floor can follow.
+ */
+static void wait_for_floor_below(struct FloorSearch *search, struct Surface *surf, f32 height, s32 order) {
+    if (search->floorFinal) {
+        return;
+    }
+    if (search->numWaiting == FLOOR_SEARCH_WINDOW) {
+        search->overflow = TRUE;
+        return;
+    }
+
+    search->waiting[search->numWaiting] = surf;
+    search->waitingHeight[search->numWaiting] = height;
+    search->waitingOrder[search->numWaiting] = order;
+    search->numWaiting++;
+}
+
+/**
+ * Adds a floor under the point that passed the 78 unit buffer to a search.
+ */
+static void add_floor_to_search(struct FloorSearch *search, struct Surface *surf, f32 height) {
+    s32 order = search->numFloors++;
+    s32 i, numWaiting;
+
+    if (search->floor != NULL && !(height > search->height)) {
+        if (search->resolveIntangible) {
+            if (is_floor_in_reach_under(search->height, height)) {
+                set_floor_below(search, surf, height, order);
+            } else {
+                wait_for_floor_below(search, surf, height, order);
+            }
+        }
+        return;
+    }
+
+    // The floor that was the highest, and the floors waiting, may be in reach of the new one.
+    if (search->resolveIntangible && search->floor != NULL) {
+        numWaiting = 0;
+        for (i = 0; i < search->numWaiting; i++) {
+            if (is_floor_in_reach_under(height, search->waitingHeight[i])) {
+                set_floor_below(search, search->waiting[i], search->waitingHeight[i], search->waitingOrder[i]);
+            } else {
+                search->waiting[numWaiting] = search->waiting[i];
+                search->waitingHeight[numWaiting] = search->waitingHeight[i];
+                search->waitingOrder[numWaiting] = search->waitingOrder[i];
+                numWaiting++;
+            }
+        }
+        search->numWaiting = numWaiting;
+
+        if (is_floor_in_reach_under(height, search->height)) {
+            set_floor_below(search, search->floor, search->height, search->floorOrder);
+        } else {
+            wait_for_floor_below(search, search->floor, search->height, search->floorOrder);
+        }
+    }
+
+    search->floor = surf;
+    search->height = height;
+    search->floorOrder = order;
+}
+
+/**
+ * Checks if the floors left in a list, which all end at or below upperY, can't
+ * change the result of a search any more.
+ */
+static s32 is_floor_search_done(struct FloorSearch *search, s16 upperY) {
+    if (search->floor == NULL || !(upperY < search->height)) {
+        return FALSE;
+    }
+
+    // The list is sorted by the highest point of each floor, so the highest floor
+    // is final, and the floors waiting will never be in reach.
+    search->floorFinal = TRUE;
+    search->numWaiting = 0;
+
+    if (!search->resolveIntangible || search->overflow || search->floor->type != SURFACE_INTANGIBLE) {
+        return TRUE;
+    }
+
+    return search->below != NULL && upperY < search->belowHeight;
+}
+
+/**
+ * Iterate through the list of floors and find the highest floor under a given point.
+ * The list is sorted by the highest point of each floor, so the search stops once
+ * the remaining floors all end below the floor found so far. The list is followed
+ * in the query's view.
+ */
+static struct Surface *find_floor_from_list(struct CollisionQueryContext *ctx, struct SurfaceNode *surfaceNode,
+                                            f32 x, f32 y, f32 z, struct FloorSearch *search) {
+    register struct Surface *surf;
+    f32 nx, ny, nz;
+    f32 oo;
+	f32 newHeight;
+    s32 view = get_surface_view(ctx);
+
+    // Iterate through the list of floors until there are no more floors.
+    while (surfaceNode != NULL) {
+        surf = surfaceNode->surface;
+        surfaceNode = SURFACE_NODE_NEXT(surfaceNode, view);
+
+        if (is_floor_search_done(search, surf->upperY)) {
+            break;
+        }
+        if (SURFACE_CHAIN_SKIPS(surf, view)) {
+            continue;
+        }
+        COUNT_SURFACE(surf, SURFACE_COUNT_TESTED);
+
+        if (!is_point_over_floor(surf, x, z)) {
+            continue;
+        }
+
+        nx = surf->normal.x;
+        ny = surf->normal.y;
+        nz = surf->normal.z;
+        oo = surf->originOffset;
+
+        // If a wall, ignore it. Likely a remnant, should never occur.
+        if (ny == 0.0f) {
+            continue;
+        }
+
+        // Find the height of the floor at a given location.
+        newHeight = -(x * nx + nz * z + oo) / ny;
+        // Checks for floor interaction with a 78 unit buffer.
+        if (y - (newHeight + -78.0f) < 0.0f) {
+            continue;
+        }
+        COUNT_SURFACE(surf, SURFACE_COUNT_PASSED);
+
+        add_floor_to_search(search, surf, newHeight);
+    }
+    return search->floor;
+}
+
+#ifdef SURFACE_SOA
+/**
+ * Same as find_floor_from_list, for a list of the static partition stored as arrays.
+ * The height checks only read the arrays, the surface is read for the floors left.
+ */
+static struct Surface *find_floor_from_array(struct CollisionQueryContext *ctx, struct SurfaceArrayRange *range,
+                                             f32 x, f32 y, f32 z, struct FloorSearch *search) {
+    struct SurfaceArrays *arrays = &gStaticSurfaceArrays;
+    struct Surface *surf;
+    f32 newHeight;
+    s32 i;
+    s32 end = range->start + range->count;
+
+    for (i = range->start; i < end; i++) {
+        if (is_floor_search_done(search, arrays->upperY[i])) {
+            break;
+        }
+        COUNT_SURFACE(arrays->surface[i], SURFACE_COUNT_TESTED);
+
+        // If a wall, ignore it. Likely a remnant, should never occur.
+        if (arrays->normalY[i] == 0.0f) {
+            continue;
+        }
+
+        newHeight = -(x * arrays->normalX[i] + arrays->normalZ[i] * z + arrays->originOffset[i])
+                    / arrays->normalY[i];
+
+        if (y - (newHeight + -78.0f) < 0.0f) {
+            continue;
+        }
+        // Lower floors only matter for the floor under an intangible floor.
+        if (search->floor != NULL && !(newHeight > search->height) && !search->resolveIntangible) {
+            continue;
+        }
+
+        surf = arrays->surface[i];
+
+        if (!is_point_over_floor(surf, x, z)) {
+            continue;
+        }
+        COUNT_SURFACE(surf, SURFACE_COUNT_PASSED);
+
+        add_floor_to_search(search, surf, newHeight);
+    }
+
+    return search->floor;
+}
+#endif
+
+/**
+ * Runs a floor search over the floors of a leaf cell of the static partition.
+ */
+static struct Surface *search_static_floors(struct CollisionQueryContext *ctx, struct SurfaceNode *staticCell,
+                                            f32 x, f32 y, f32 z, struct FloorSearch *search) {
+    s32 view = get_surface_view(ctx);
+
+#ifdef SURFACE_SOA
+    return find_floor_from_array(ctx, &get_static_ranges(staticCell, view)[SPATIAL_PARTITION_FLOORS], x, y, z,
+                                 search);
+#else
+    return find_floor_from_list(ctx, get_surface_list(staticCell, SPATIAL_PARTITION_FLOORS, view), x, y, z, search);
+#endif
+}
+
+/**
+ * Find the highest floor under a point in a leaf cell of the static partition.
+ *
+ * To prevent the Merry-Go-Round room from loading when Mario passes above the hole that leads
+ * there, SURFACE_INTANGIBLE is used. This prevent the wrong room from loading, but can also allow
+ * Mario to pass through. Unless the query includes intangible floors, such a floor is replaced by
+ * the floor a search from 200 units under it finds, which the same pass over the list finds too.
+ */
+static struct Surface *find_static_floor(struct CollisionQueryContext *ctx, struct SurfaceNode *staticCell,
+                                         f32 x, f32 y, f32 z, f32 *pheight) {
+    struct FloorSearch search;
+
+    init_floor_search(&search, !ctx->includeIntangible);
+
+    if (search_static_floors(ctx, staticCell, x, y, z, &search) == NULL) {
+        return NULL;
+    }
+    *pheight = search.height;
+
+    if (!search.resolveIntangible || search.floor->type != SURFACE_INTANGIBLE) {
+        return search.floor;
+    }
+
+    //! (BBH Crash) Most NULL checking is done by checking the height of the floor returned
+    //  instead of checking directly for a NULL floor. If this check returns a NULL floor
+    //  (happens when there is no floor under the SURFACE_INTANGIBLE floor) but returns the height
+    //  of the SURFACE_INTANGIBLE floor instead of the typical -11000 returned for a NULL floor.
+    if (search.overflow) {
+        init_floor_search(&search, FALSE);
+        if (search_static_floors(ctx, staticCell, x, (f32)(*pheight - 200.0f), z, &search) != NULL) {
+            *pheight = search.height;
+        }
+        return search.floor;
     }
 
-    *pceil = ceil;
+    if (search.below != NULL) {
+        *pheight = search.belowHeight;
+    }
+    return search.below;
+}
 
-    // Increment the debug tracker.
-    gNumCalls.ceil += 1;
+/**
+ * Returns the floor hint of the caller of a query. Mario and the camera keep their
+ * own, so the queries of other objects in between don't replace them.
+ */
+static struct StaticFloorHint *get_static_floor_hint(struct CollisionQueryContext *ctx) {
+    if (ctx->checkingForCamera) {
+        return &ctx->floorHints[FLOOR_HINT_CAMERA];
+    }
+    if (ctx->currentObject != NULL && ctx->currentObject == ctx->marioObject) {
+        return &ctx->floorHints[FLOOR_HINT_MARIO];
+    }
 
-    return height;
+    return &ctx->floorHints[FLOOR_HINT_OBJECTS];
 }
 
-/**************************************************
- *                     FLOORS                     *
- **************************************************/
-
 /**
- * Find the height of the highest floor below an object.
+ * Checks a floor with the tests of a floor search: the point is over it, and its
+ * height there passes the 78 unit buffer. Writes the height to pheight.
  */
-f32 unused_obj_find_floor_height(struct Object *obj) {
-    struct Surface *floor;
-    f32 floorHeight = find_floor(obj->oPosX, obj->oPosY, obj->oPosZ, &floor);
-    return floorHeight;
+static s32 is_floor_under_point(struct Surface *surf, f32 x, f32 y, f32 z, f32 *pheight) {
+    if (!is_point_over_floor(surf, x, z)) {
+        return FALSE;
+    }
+
+    *pheight = -(x * surf->normal.x + surf->normal.z * z + surf->originOffset) / surf->normal.y;
+
+    return !(y - (*pheight + -78.0f) < 0.0f);
 }
 
 /**
- * Basically a local variable that passes through floor geo info.
+ * Returns the hinted floor if a search of its leaf cell would take it, and writes its
+ * height to pheight. The point has to be within the floor's bounds, so only the rivals
+ * of the floor can be over the point. The floor is then the highest one if no rival
+ * passes the search's tests as high as it.
  */
-struct FloorGeometry sFloorGeo;
+static struct Surface *check_static_floor_hint(struct StaticFloorHint *hint, f32 x, f32 y, f32 z,
+                                               f32 *pheight) {
+    f32 height, rivalHeight;
+    s32 i;
 
-static u8 unused8038BE50[0x40];
+    if (x < hint->minX || x > hint->maxX || z < hint->minZ || z > hint->maxZ) {
+        return NULL;
+    }
+    if (!is_floor_under_point(hint->floor, x, y, z, &height)) {
+        return NULL;
+    }
+
+    for (i = 0; i < hint->numRivals; i++) {
+        // A floor as high may come first in the list order and take the search.
+        if (is_floor_under_point(hint->rivals[i], x, y, z, &rivalHeight) && !(rivalHeight < height)) {
+            return NULL;
+        }
+    }
+
+    COUNT_SURFACE(hint->floor, SURFACE_COUNT_TESTED);
+    *pheight = height;
+    return hint->floor;
+}
 
 /**
- * Return the floor height underneath (xPos, yPos, zPos) and populate `floorGeo`
- * with data about the floor's normal vector and origin offset. Also update
- * sFloorGeo.
+ * Writes the lateral bounds of a surface, the lowest and highest x and z of its vertices.
  */
-f32 find_floor_height_and_data(f32 xPos, f32 yPos, f32 zPos, struct FloorGeometry **floorGeo) {
-    struct Surface *floor;
-    f32 floorHeight = find_floor(xPos, yPos, zPos, &floor);
+static void get_surface_bounds(struct Surface *surf, s16 *minX, s16 *maxX, s16 *minZ, s16 *maxZ) {
+    s16 *vertices[3];
+    s32 i;
 
-    *floorGeo = NULL;
+    vertices[0] = surf->vertex1;
+    vertices[1] = surf->vertex2;
+    vertices[2] = surf->vertex3;
 
-    if (floor != NULL) {
-        sFloorGeo.normalX = floor->normal.x;
-        sFloorGeo.normalY = floor->normal.y;
-        sFloorGeo.normalZ = floor->normal.z;
-        sFloorGeo.originOffset = floor->originOffset;
+    *minX = *maxX = vertices[0][0];
+    *minZ = *maxZ = vertices[0][2];
 
-        *floorGeo = &sFloorGeo;
+    for (i = 1; i < 3; i++) {
+        if (vertices[i][0] < *minX) {
+            *minX = vertices[i][0];
+        }
+        if (vertices[i][0] > *maxX) {
+            *maxX = vertices[i][0];
+        }
+        if (vertices[i][2] < *minZ) {
+            *minZ = vertices[i][2];
+        }
+        if (vertices[i][2] > *maxZ) {
+            *maxZ = vertices[i][2];
+        }
     }
-    return floorHeight;
 }
 
 /**
- * Iterate through the list of floors and find the first floor under a given point.
+ * Adds a floor of the hint's leaf cell to its rivals if it may be over a point within
+ * the bounds of the hinted floor. Returns FALSE if there are too many rivals.
  */
-static struct Surface *find_floor_from_list(struct SurfaceNode *surfaceNode, f32 x, f32 y, f32 z, f32 *pheight) {
-    register struct Surface *surf;
-    register f32 x1, z1, x2, z2, x3, z3;
-    f32 nx, ny, nz;
-    f32 oo;
-    f32 height;
-	f32 newHeight;
-    struct Surface *floor = NULL;
+static s32 add_floor_hint_rival(struct StaticFloorHint *hint, struct Surface *surf) {
+    s16 minX, maxX, minZ, maxZ;
 
-    // Iterate through the list of floors until there are no more floors.
-    while (surfaceNode != NULL) {
-        surf = surfaceNode->surface;
-        surfaceNode = surfaceNode->next;
+    if (surf == hint->floor) {
+        return TRUE;
+    }
+
+    get_surface_bounds(surf, &minX, &maxX, &minZ, &maxZ);
+    if (minX > hint->maxX || maxX < hint->minX || minZ > hint->maxZ || maxZ < hint->minZ) {
+        return TRUE;
+    }
+    if (hint->numRivals == FLOOR_HINT_RIVALS_MAX) {
+        return FALSE;
+    }
 
-        x1 = surf->vertex1[0];
-        z1 = surf->vertex1[2];
-        x2 = surf->vertex2[0];
-        z2 = surf->vertex2[2];
+    hint->rivals[hint->numRivals++] = surf;
+    return TRUE;
+}
 
-        // Check that the point is within the triangle bounds.
-        if ((z1 - z) * (x2 - x1) - (x1 - x) * (z2 - z1) < 0) {
-            continue;
-        }
+/**
+ * Makes the floor a search of a leaf cell took the caller's hint. The floors of the list
+ * are sorted by their highest point, so the ones ending below the lowest point of the
+ * floor can't be as high as it, and only the others are looked at. If too many of them
+ * overlap the floor, or the search resolved an intangible floor, there's no hint.
+ */
+static void set_static_floor_hint(struct CollisionQueryContext *ctx, struct StaticFloorHint *hint,
+                                  struct SurfaceNode *staticCell, struct Surface *floor) {
+    s32 view = get_surface_view(ctx);
+#ifdef SURFACE_SOA
+    struct SurfaceArrayRange *range = &get_static_ranges(staticCell, view)[SPATIAL_PARTITION_FLOORS];
+    s32 i;
+#else
+    struct SurfaceNode *surfaceNode = get_surface_list(staticCell, SPATIAL_PARTITION_FLOORS, view);
+    struct Surface *surf;
+#endif
 
-        // To slightly save on computation time, set this later.
-        x3 = surf->vertex3[0];
-        z3 = surf->vertex3[2];
+    hint->floor = NULL;
+    if (floor == NULL || (floor->type == SURFACE_INTANGIBLE && !ctx->includeIntangible)) {
+        return;
+    }
 
-        if ((z2 - z) * (x3 - x2) - (x2 - x) * (z3 - z2) < 0) {
-            continue;
+    hint->staticCell = staticCell;
+    hint->view = view;
+    hint->includeIntangible = ctx->includeIntangible;
+    get_surface_bounds(floor, &hint->minX, &hint->maxX, &hint->minZ, &hint->maxZ);
+    hint->numRivals = 0;
+    hint->floor = floor;
+
+#ifdef SURFACE_SOA
+    for (i = range->start; i < range->start + range->count; i++) {
+        if (gStaticSurfaceArrays.upperY[i] < floor->lowerY) {
+            break;
         }
-        if ((z3 - z) * (x1 - x3) - (x3 - x) * (z1 - z3) < 0) {
-            continue;
+        if (!add_floor_hint_rival(hint, gStaticSurfaceArrays.surface[i])) {
+            hint->floor = NULL;
+            return;
         }
+    }
+#else
+    while (surfaceNode != NULL) {
+        surf = surfaceNode->surface;
+        surfaceNode = SURFACE_NODE_NEXT(surfaceNode, view);
 
-        // Determine if we are checking for the camera or not.
-        if (gCheckingSurfaceCollisionsForCamera != 0) {
-            if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
-                continue;
-            }
+        if (surf->upperY < floor->lowerY) {
+            break;
         }
-        // If we are not checking for the camera, ignore camera only floors.
-        else if (surf->type == SURFACE_CAMERA_BOUNDARY) {
+        if (SURFACE_CHAIN_SKIPS(surf, view)) {
             continue;
         }
-
-        nx = surf->normal.x;
-        ny = surf->normal.y;
-        nz = surf->normal.z;
-        oo = surf->originOffset;
-
-        // If a wall, ignore it. Likely a remnant, should never occur.
-        if (ny == 0.0f) {
-            continue;
-        }
-
-        // Find the height of the floor at a given location.
-        newHeight = -(x * nx + nz * z + oo) / ny;
-        // Checks for floor interaction with a 78 unit buffer.
-        if (y - (newHeight + -78.0f) < 0.0f) {
-            continue;
+        if (!add_floor_hint_rival(hint, surf)) {
+            hint->floor = NULL;
+            return;
         }
-
-		if (floor == NULL || newHeight > height) {
-			height = newHeight;
-			*pheight = height;
-			floor = surf;
-		}
     }
-    return floor;
+#endif
 }
 
 /**
- * Find the height of the highest floor below a point.
+ * Find the highest floor under a given position in an object cell and a static cell.
+ * Level geometry does not change after loading, so each caller keeps the level geometry
+ * floor it last found as a hint. Mario stays over the same floor for most quarter steps
+ * and for update_mario_geometry_inputs, and while the hint provably still is the highest
+ * floor only the object floors are searched.
  */
-f32 find_floor_height(f32 x, f32 y, f32 z) {
-    struct Surface *floor;
+static f32 find_floor_in_cells(struct CollisionQueryContext *ctx, struct SurfaceNode *dynamicCell,
+                               struct SurfaceNode *staticCell, f32 xPos, f32 yPos, f32 zPos,
+                               struct Surface **pfloor) {
+    struct StaticFloorHint *hint = get_static_floor_hint(ctx);
+    struct Surface *floor, *dynamicFloor;
+    struct SurfaceNode *surfaceList;
+    struct FloorSearch dynamicSearch;
 
-    f32 floorHeight = find_floor(x, y, z, &floor);
+    f32 height = FLOOR_LOWER_LIMIT;
+    f32 dynamicHeight = FLOOR_LOWER_LIMIT;
 
-    return floorHeight;
-}
+    // Check for surfaces belonging to objects.
+    surfaceList = get_surface_list(dynamicCell, SPATIAL_PARTITION_FLOORS, get_surface_view(ctx));
+    init_floor_search(&dynamicSearch, FALSE);
+    dynamicFloor = find_floor_from_list(ctx, surfaceList, xPos, yPos, zPos, &dynamicSearch);
+    if (dynamicFloor != NULL) {
+        dynamicHeight = dynamicSearch.height;
+    }
 
-/**
- * Find the highest dynamic floor under a given position. Perhaps originally static
- * and dynamic floors were checked separately.
- */
-f32 unused_find_dynamic_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
-    struct SurfaceNode *surfaceList;
-    struct Surface *floor;
-    f32 floorHeight = FLOOR_LOWER_LIMIT;
+    floor = NULL;
+    if (hint->floor != NULL && hint->staticCell == staticCell && hint->view == get_surface_view(ctx)
+        && hint->includeIntangible == ctx->includeIntangible) {
+        floor = check_static_floor_hint(hint, xPos, yPos, zPos, &height);
+    }
 
-    // Would normally cause PUs, but dynamic floors unload at that range.
-    s16 x = (s16) xPos;
-    s16 y = (s16) yPos;
-    s16 z = (s16) zPos;
+    if (floor == NULL) {
+        // Check for surfaces that are a part of level geometry.
+        floor = find_static_floor(ctx, staticCell, xPos, yPos, zPos, &height);
+        set_static_floor_hint(ctx, hint, staticCell, floor);
+    }
 
-    // Each level is split into cells to limit load, find the appropriate cell.
-    s16 cellX = ((x + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
-    s16 cellZ = ((z + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
+    // To prevent accidentally leaving the floor tangible, stop checking for it.
+    ctx->includeIntangible = FALSE;
+
+    // If a floor was missed, increment the debug counter.
+    if (floor == NULL) {
+        ctx->numFloorMisses += 1;
+    }
 
-    surfaceList = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next;
-    floor = find_floor_from_list(surfaceList, x, y, z, &floorHeight);
+    if (dynamicHeight > height) {
+        floor = dynamicFloor;
+        height = dynamicHeight;
+    }
 
     *pfloor = floor;
+    COUNT_SURFACE(floor, SURFACE_COUNT_HIT);
 
-    return floorHeight;
+    // Increment the debug tracker.
+    ctx->numCalls.floor += 1;
+
+    return height;
 }
 
 /**
  * Find the highest floor under a given position and return the height.
  */
-f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
+f32 find_floor_ctx(struct CollisionQueryContext *ctx, f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
     s16 cellZ, cellX;
 
-    struct Surface *floor, *dynamicFloor;
-    struct SurfaceNode *surfaceList;
-
-    f32 height = FLOOR_LOWER_LIMIT;
-    f32 dynamicHeight = FLOOR_LOWER_LIMIT;
-
     //! (Parallel Universes) Because position is casted to an s16, reaching higher
     // float locations  can return floors despite them not existing there.
     //(Dynamic floors will unload due to the range.)
@@ -618,56 +1841,75 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
     *pfloor = NULL;
 
     if (xPos <= -LEVEL_BOUNDARY_MAX || xPos >= LEVEL_BOUNDARY_MAX) {
-        return height;
+        return FLOOR_LOWER_LIMIT;
     }
     if (zPos <= -LEVEL_BOUNDARY_MAX || zPos >= LEVEL_BOUNDARY_MAX) {
-        return height;
+        return FLOOR_LOWER_LIMIT;
     }
 
     // Each level is split into cells to limit load, find the appropriate cell.
     cellX = (((s32)xPos + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
     cellZ = (((s32)zPos + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
 
-    // Check for surfaces belonging to objects.
-    surfaceList = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next;
-    dynamicFloor = find_floor_from_list(surfaceList, xPos, yPos, zPos, &dynamicHeight);
+    return find_floor_in_cells(ctx, ctx->dynamicPartition[cellZ][cellX],
+                               get_static_cell((s32)xPos + LEVEL_BOUNDARY_MAX, (s32)zPos + LEVEL_BOUNDARY_MAX),
+                               xPos, yPos, zPos, pfloor);
+}
 
-    // Check for surfaces that are a part of level geometry.
-    surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next;
-    floor = find_floor_from_list(surfaceList, xPos, yPos, zPos, &height);
-
-    // To prevent the Merry-Go-Round room from loading when Mario passes above the hole that leads
-    // there, SURFACE_INTANGIBLE is used. This prevent the wrong room from loading, but can also allow
-    // Mario to pass through.
-    if (!gFindFloorIncludeSurfaceIntangible) {
-        //! (BBH Crash) Most NULL checking is done by checking the height of the floor returned
-        //  instead of checking directly for a NULL floor. If this check returns a NULL floor
-        //  (happens when there is no floor under the SURFACE_INTANGIBLE floor) but returns the height
-        //  of the SURFACE_INTANGIBLE floor instead of the typical -11000 returned for a NULL floor.
-        if (floor != NULL && floor->type == SURFACE_INTANGIBLE) {
-            floor = find_floor_from_list(surfaceList, xPos, (f32)(height - 200.0f), zPos, &height);
-        }
-    } else {
-        // To prevent accidentally leaving the floor tangible, stop checking for it.
-        gFindFloorIncludeSurfaceIntangible = FALSE;
-    }
+f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
+    struct CollisionQueryContext *ctx = begin_game_query();
+    f32 height = find_floor_ctx(ctx, xPos, yPos, zPos, pfloor);
 
-    // If a floor was missed, increment the debug counter.
-    if (floor == NULL) {
-        gNumFindFloorMisses += 1;
+    end_game_query(ctx);
+    return height;
+}
+
+/**
+ * Find the highest floor under a position and the lowest ceiling above it in one
+ * query, looking up the cells only once. The ceiling is searched from ceilY, or from
+ * 80 units above the floor found if ceilY is FIND_CEIL_ABOVE_FLOOR, like vec3f_find_ceil.
+ * Returns the floor height.
+ */
+f32 find_floor_and_ceil_ctx(struct CollisionQueryContext *ctx, f32 xPos, f32 yPos, f32 zPos, f32 ceilY,
+                            struct Surface **pfloor, struct Surface **pceil, f32 *pceilHeight) {
+    s16 cellZ, cellX;
+    struct SurfaceNode *dynamicCell, *staticCell;
+    f32 floorHeight;
+
+    *pfloor = NULL;
+    *pceil = NULL;
+    *pceilHeight = CELL_HEIGHT_LIMIT;
+
+    if (xPos <= -LEVEL_BOUNDARY_MAX || xPos >= LEVEL_BOUNDARY_MAX) {
+        return FLOOR_LOWER_LIMIT;
+    }
+    if (zPos <= -LEVEL_BOUNDARY_MAX || zPos >= LEVEL_BOUNDARY_MAX) {
+        return FLOOR_LOWER_LIMIT;
     }
 
-    if (dynamicHeight > height) {
-        floor = dynamicFloor;
-        height = dynamicHeight;
+    cellX = (((s32)xPos + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
+    cellZ = (((s32)zPos + LEVEL_BOUNDARY_MAX) / CELL_SIZE) & NUM_CELLS_INDEX;
+
+    dynamicCell = ctx->dynamicPartition[cellZ][cellX];
+    staticCell = get_static_cell((s32)xPos + LEVEL_BOUNDARY_MAX, (s32)zPos + LEVEL_BOUNDARY_MAX);
+
+    floorHeight = find_floor_in_cells(ctx, dynamicCell, staticCell, xPos, yPos, zPos, pfloor);
+
+    if (ceilY == FIND_CEIL_ABOVE_FLOOR) {
+        ceilY = floorHeight + 80.0f;
     }
+    *pceilHeight = find_ceil_in_cells(ctx, dynamicCell, staticCell, xPos, ceilY, zPos, pceil);
 
-    *pfloor = floor;
+    return floorHeight;
+}
 
-    // Increment the debug tracker.
-    gNumCalls.floor += 1;
+f32 find_floor_and_ceil(f32 xPos, f32 yPos, f32 zPos, f32 ceilY, struct Surface **pfloor,
+                        struct Surface **pceil, f32 *pceilHeight) {
+    struct CollisionQueryContext *ctx = begin_game_query();
+    f32 floorHeight = find_floor_and_ceil_ctx(ctx, xPos, yPos, zPos, ceilY, pfloor, pceil, pceilHeight);
 
-    return height;
+    end_game_query(ctx);
+    return floorHeight;
 }
 
 /**************************************************
@@ -675,36 +1917,77 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
  **************************************************/
 
 /**
- * Finds the height of water at a given location.
+ * Finds the heights of the first water region and the first poison gas region
+ * containing a location. Either height pointer may be NULL to skip that search.
  */
-f32 find_water_level(f32 x, f32 z) {
+static void find_environment_region_levels(f32 x, f32 z, f32 *waterLevel, f32 *gasLevel) {
     s32 i;
     s32 numRegions;
+    s32 cell;
     s16 val;
     f32 loX, hiX, loZ, hiZ;
-    f32 waterLevel = FLOOR_LOWER_LIMIT;
-    s16 *p = gEnvironmentRegions;
+    s16 *cellRegions = NULL;
+    s16 *p;
+    s32 findWater = waterLevel != NULL;
+    s32 findGas = gasLevel != NULL;
+
+    if (findWater) {
+        *waterLevel = FLOOR_LOWER_LIMIT;
+    }
+    if (findGas) {
+        *gasLevel = FLOOR_LOWER_LIMIT;
+    }
+
+    if (gEnvironmentRegions == NULL) {
+        return;
+    }
+
+    numRegions = gEnvironmentRegions[0];
+
+    // Only the regions overlapping the cell of the location can contain it.
+    if (gEnvironmentCellsValid && -LEVEL_BOUNDARY_MAX < x && x < LEVEL_BOUNDARY_MAX
+        && -LEVEL_BOUNDARY_MAX < z && z < LEVEL_BOUNDARY_MAX) {
+        cell = (((s32)z + LEVEL_BOUNDARY_MAX) / CELL_SIZE) * NUM_CELLS
+             + ((s32)x + LEVEL_BOUNDARY_MAX) / CELL_SIZE;
+        cellRegions = &gEnvironmentCellRegions[gEnvironmentCellStart[cell]];
+        numRegions = gEnvironmentCellStart[cell + 1] - gEnvironmentCellStart[cell];
+    }
 
-    if (p != NULL) {
-        numRegions = *p++;
+    for (i = 0; i < numRegions && (findWater || findGas); i++) {
+        p = &gEnvironmentRegions[1 + 6 * (cellRegions != NULL ? cellRegions[i] : i)];
 
-        for (i = 0; i < numRegions; i++) {
-            val = *p++;
-            loX = *p++;
-            loZ = *p++;
-            hiX = *p++;
-            hiZ = *p++;
+        val = p[0];
+        loX = p[1];
+        loZ = p[2];
+        hiX = p[3];
+        hiZ = p[4];
 
-            // If the location is within a water box and it is a water box.
+        if (loX < x && x < hiX && loZ < z && z < hiZ) {
             // Water is less than 50 val only, while above is gas and such.
-            if (loX < x && x < hiX && loZ < z && z < hiZ && val < 50) {
-                // Set the water height. Since this breaks, only return the first height.
-                waterLevel = *p;
-                break;
+            // Gas has a value of 50, 60, etc.
+            // Only the first height of each is returned.
+            if (val < 50) {
+                if (findWater) {
+                    *waterLevel = p[5];
+                    findWater = FALSE;
+                }
+            } else if (val % 10 == 0) {
+                if (findGas) {
+                    *gasLevel = p[5];
+                    findGas = FALSE;
+                }
             }
-            p++;
         }
     }
+}
+
+/**
+ * Finds the height of water at a given location.
+ */
+f32 find_water_level(f32 x, f32 z) {
+    f32 waterLevel;
+
+    find_environment_region_levels(x, z, &waterLevel, NULL);
 
     return waterLevel;
 }
@@ -713,46 +1996,143 @@ f32 find_water_level(f32 x, f32 z) {
  * Finds the height of the poison gas (used only in HMC) at a given location.
  */
 f32 find_poison_gas_level(f32 x, f32 z) {
-    s32 i;
-    s32 numRegions;
-    UNUSED s32 unused;
-    s16 val;
-    f32 loX, hiX, loZ, hiZ;
-    f32 gasLevel = FLOOR_LOWER_LIMIT;
-    s16 *p = gEnvironmentRegions;
-
-    if (p != NULL) {
-        numRegions = *p++;
-
-        for (i = 0; i < numRegions; i++) {
-            val = *p;
-
-            if (val >= 50) {
-                loX = p[1];
-                loZ = p[2];
-                hiX = p[3];
-                hiZ = p[4];
-
-                // If the location is within a gas's box and it is a gas box.
-                // Gas has a value of 50, 60, etc.
-                if (loX < x && x < hiX && loZ < z && z < hiZ && val % 10 == 0) {
-                    // Set the gas height. Since this breaks, only return the first height.
-                    gasLevel = p[5];
-                    break;
-                }
-            }
+    f32 gasLevel;
 
-            p += 6;
-        }
-    }
+    find_environment_region_levels(x, z, NULL, &gasLevel);
 
     return gasLevel;
 }
 
+/**
+ * Finds the heights of water and poison gas at a given location with one lookup.
+ */
+void find_environment_levels(f32 x, f32 z, f32 *waterLevel, f32 *gasLevel) {
+    find_environment_region_levels(x, z, waterLevel, gasLevel);
+}
+
 /**************************************************
  *                      DEBUG                     *
  **************************************************/
 
+#ifdef COLLISION_INSTRUMENTATION
+/**
+ * Clears the counts of all level surfaces, called when new terrain is loaded.
+ */
+void clear_surface_hit_counts(void) {
+    s32 i, j;
+
+    for (i = 0; i < SURFACE_POOL_SIZE; i++) {
+        for (j = 0; j < NUM_SURFACE_COUNTS; j++) {
+            gSurfaceHitCounts[i][j] = 0;
+        }
+    }
+}
+
+/**
+ * Returns the index of the level surface tested most, or -1 if none was tested.
+ */
+static s32 find_hottest_surface(void) {
+    s32 hottest = -1;
+    u32 maxTested = 0;
+    s32 i;
+
+    for (i = 0; i < gNumStaticSurfaces; i++) {
+        if (gSurfaceHitCounts[i][SURFACE_COUNT_TESTED] > maxTested) {
+            maxTested = gSurfaceHitCounts[i][SURFACE_COUNT_TESTED];
+            hottest = i;
+        }
+    }
+
+    return hottest;
+}
+
+#ifndef TARGET_N64
+/**
+ * Returns the list name of a surface, as add_surface_to_cell sorts them.
+ */
+static const char *get_surface_kind_name(struct Surface *surf) {
+    if (surf->normal.y > 0.01) {
+        return "floor";
+    }
+    if (surf->normal.y < -0.01) {
+        return "ceil";
+    }
+    return "wall";
+}
+
+/**
+ * Writes the counts of every level surface as CSV, with its type and the center
+ * of its vertices. Returns FALSE if the file could not be written.
+ */
+s32 write_surface_hit_counts(const char *path) {
+    FILE *file = fopen(path, "w");
+    struct Surface *surf;
+    s32 i;
+
+    if (file == NULL) {
+        return FALSE;
+    }
+
+    fprintf(file, "index,kind,type,x,y,z,tested,passed,hit\n");
+    for (i = 0; i < gNumStaticSurfaces; i++) {
+        surf = &sSurfacePool[i];
+        fprintf(file, "%d,%s,%d,%d,%d,%d,%u,%u,%u\n", i, get_surface_kind_name(surf), surf->type,
+                (surf->vertex1[0] + surf->vertex2[0] + surf->vertex3[0]) / 3,
+                (surf->vertex1[1] + surf->vertex2[1] + surf->vertex3[1]) / 3,
+                (surf->vertex1[2] + surf->vertex2[2] + surf->vertex3[2]) / 3,
+                gSurfaceHitCounts[i][SURFACE_COUNT_TESTED], gSurfaceHitCounts[i][SURFACE_COUNT_PASSED],
+                gSurfaceHitCounts[i][SURFACE_COUNT_HIT]);
+    }
+
+    return fclose(file) == 0;
+}
+
+/**
+ * Writes the counts of the level surfaces summed over each of the 16x16 cells,
+ * counting every surface in the cell containing the center of its vertices.
+ * Returns FALSE if the file could not be written.
+ */
+s32 write_cell_hit_counts(const char *path) {
+    static u32 cellCounts[NUM_CELLS][NUM_CELLS][NUM_SURFACE_COUNTS + 1];
+    FILE *file;
+    struct Surface *surf;
+    s32 cellX, cellZ;
+    s32 i, j;
+
+    bzero(cellCounts, sizeof(cellCounts));
+
+    for (i = 0; i < gNumStaticSurfaces; i++) {
+        surf = &sSurfacePool[i];
+        cellX = ((surf->vertex1[0] + surf->vertex2[0] + surf->vertex3[0]) / 3 + LEVEL_BOUNDARY_MAX) / CELL_SIZE;
+        cellZ = ((surf->vertex1[2] + surf->vertex2[2] + surf->vertex3[2]) / 3 + LEVEL_BOUNDARY_MAX) / CELL_SIZE;
+        cellX &= NUM_CELLS_INDEX;
+        cellZ &= NUM_CELLS_INDEX;
+
+        cellCounts[cellZ][cellX][NUM_SURFACE_COUNTS]++;
+        for (j = 0; j < NUM_SURFACE_COUNTS; j++) {
+            cellCounts[cellZ][cellX][j] += gSurfaceHitCounts[i][j];
+        }
+    }
+
+    file = fopen(path, "w");
+    if (file == NULL) {
+        return FALSE;
+    }
+
+    fprintf(file, "cell_x,cell_z,surfaces,tested,passed,hit\n");
+    for (cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+        for (cellX = 0; cellX < NUM_CELLS; cellX++) {
+            fprintf(file, "%d,%d,%u,%u,%u,%u\n", cellX, cellZ, cellCounts[cellZ][cellX][NUM_SURFACE_COUNTS],
+                    cellCounts[cellZ][cellX][SURFACE_COUNT_TESTED], cellCounts[cellZ][cellX][SURFACE_COUNT_PASSED],
+                    cellCounts[cellZ][cellX][SURFACE_COUNT_HIT]);
+        }
+    }
+
+    return fclose(file) == 0;
+}
+#endif
+#endif
+
 /**
  * Finds the length of a surface list for debug purposes.
  */
@@ -773,6 +2153,11 @@ static s32 surface_list_length(struct SurfaceNode *list) {
  */
 void debug_surface_list_info(f32 xPos, f32 zPos) {
     struct SurfaceNode *list;
+    struct SurfaceNode *staticCell;
+    s32 band;
+#ifdef COLLISION_INSTRUMENTATION
+    s32 hottest;
+#endif
     s32 numFloors = 0;
     s32 numWalls = 0;
     s32 numCeils = 0;
@@ -780,25 +2165,31 @@ void debug_surface_list_info(f32 xPos, f32 zPos) {
     s32 cellX = (xPos + LEVEL_BOUNDARY_MAX) / CELL_SIZE;
     s32 cellZ = (zPos + LEVEL_BOUNDARY_MAX) / CELL_SIZE;
 
-    list = gStaticSurfacePartition[cellZ & NUM_CELLS_INDEX][cellX & NUM_CELLS_INDEX][SPATIAL_PARTITION_FLOORS].next;
+    staticCell = get_static_cell((s32)xPos + LEVEL_BOUNDARY_MAX, (s32)zPos + LEVEL_BOUNDARY_MAX);
+
+    list = staticCell[SPATIAL_PARTITION_FLOORS].next;
     numFloors += surface_list_length(list);
 
     list = gDynamicSurfacePartition[cellZ & NUM_CELLS_INDEX][cellX & NUM_CELLS_INDEX][SPATIAL_PARTITION_FLOORS].next;
     numFloors += surface_list_length(list);
 
-    list = gStaticSurfacePartition[cellZ & NUM_CELLS_INDEX][cellX & NUM_CELLS_INDEX][SPATIAL_PARTITION_WALLS].next;
-    numWalls += surface_list_length(list);
+    // Walls spanning several bands are counted once per band.
+    for (band = SPATIAL_PARTITION_WALLS; band < SPATIAL_PARTITION_WALLS + NUM_WALL_BANDS; band++) {
+        list = staticCell[band].next;
+        numWalls += surface_list_length(list);
 
-    list = gDynamicSurfacePartition[cellZ & NUM_CELLS_INDEX][cellX & NUM_CELLS_INDEX][SPATIAL_PARTITION_WALLS].next;
-    numWalls += surface_list_length(list);
+        list = gDynamicSurfacePartition[cellZ & NUM_CELLS_INDEX][cellX & NUM_CELLS_INDEX][band].next;
+        numWalls += surface_list_length(list);
+    }
 
-    list = gStaticSurfacePartition[cellZ & NUM_CELLS_INDEX][cellX & NUM_CELLS_INDEX][SPATIAL_PARTITION_CEILS].next;
+    list = staticCell[SPATIAL_PARTITION_CEILS].next;
     numCeils += surface_list_length(list);
 
     list = gDynamicSurfacePartition[cellZ & NUM_CELLS_INDEX][cellX & NUM_CELLS_INDEX][SPATIAL_PARTITION_CEILS].next;
     numCeils += surface_list_length(list);
 
     print_debug_top_down_mapinfo("area   %x", cellZ * NUM_CELLS + cellX);
+    print_debug_top_down_mapinfo("sub    %d", gStaticCells[cellZ & NUM_CELLS_INDEX][cellX & NUM_CELLS_INDEX].subdivision);
 
     // Names represent ground, walls, and roofs as found in SMS.
     print_debug_top_down_mapinfo("dg %d", numFloors);
@@ -811,16 +2202,37 @@ void debug_surface_list_info(f32 xPos, f32 zPos) {
     print_debug_top_down_mapinfo("%d", gNumCalls.wall);
     print_debug_top_down_mapinfo("%d", gNumCalls.ceil);
 
-    set_text_array_x_y(-80, 0);
+    set_text_array_x_y(40, -3);
+
+    // Queries saved by shortened ground steps.
+    print_debug_top_down_mapinfo("-%d", gNumSkippedCalls.floor);
+    print_debug_top_down_mapinfo("-%d", gNumSkippedCalls.wall);
+    print_debug_top_down_mapinfo("-%d", gNumSkippedCalls.ceil);
+
+    set_text_array_x_y(-120, 0);
 
     // listal- List Allocated?, statbg- Static Background?, movebg- Moving Background?
     print_debug_top_down_mapinfo("listal %d", gSurfaceNodesAllocated);
     print_debug_top_down_mapinfo("statbg %d", gNumStaticSurfaces);
     print_debug_top_down_mapinfo("movebg %d", gSurfacesAllocated - gNumStaticSurfaces);
 
+#ifdef COLLISION_INSTRUMENTATION
+    // The level surface tested most since the level was loaded.
+    hottest = find_hottest_surface();
+    if (hottest >= 0) {
+        print_debug_top_down_mapinfo("hot %d", hottest);
+        print_debug_top_down_mapinfo("test %d", gSurfaceHitCounts[hottest][SURFACE_COUNT_TESTED]);
+        print_debug_top_down_mapinfo("hit %d", gSurfaceHitCounts[hottest][SURFACE_COUNT_HIT]);
+    }
+#endif
+
     gNumCalls.floor = 0;
     gNumCalls.ceil = 0;
     gNumCalls.wall = 0;
+
+    gNumSkippedCalls.floor = 0;
+    gNumSkippedCalls.ceil = 0;
+    gNumSkippedCalls.wall = 0;
 }
 
 /**
@@ -10,6 +10,9 @@
 
 #define CELL_SIZE           (1 << 10) // 0x400
 
+// Uses LEVEL_BOUNDARY_MAX and CELL_SIZE.
+#include "surface_load.h"
+
 #define CELL_HEIGHT_LIMIT           20000
 #define FLOOR_LOWER_LIMIT           -11000
 #define FLOOR_LOWER_LIMIT_MISC      (FLOOR_LOWER_LIMIT + 1000)
@@ -17,6 +20,10 @@
 // It doesn't match if ".0" is removed or ".f" is added
 #define FLOOR_LOWER_LIMIT_SHADOW    (FLOOR_LOWER_LIMIT + 1000.0)
 
+// Passed as ceilY to find_floor_and_ceil to search for the ceiling from 80 units
+// above the floor found.
+#define FIND_CEIL_ABOVE_FLOOR       -32768.0f
+
 struct WallCollisionData
 {
     /*0x00*/ f32 x, y, z;
@@ -27,6 +34,10 @@ struct WallCollisionData
     /*0x18*/ struct Surface *walls[4];
 };
 
+// Walls find_wall_collisions_multi can test its spheres against before falling back
+// to separate queries.
+#define WALL_CANDIDATES_MAX 64
+
 struct FloorGeometry
 {
     f32 unused[4]; // possibly position data?
@@ -36,14 +47,129 @@ struct FloorGeometry
     f32 originOffset;
 };
 
+// Host builds running collision queries on several threads, see
+// set_thread_collision_query_context.
+//#define COLLISION_THREADS
+
+#ifdef COLLISION_THREADS
+#define COLLISION_THREAD_LOCAL __thread
+#else
+#define COLLISION_THREAD_LOCAL
+#endif
+
+// Counts how often the queries test every level surface, see gSurfaceHitCounts.
+//#define COLLISION_INSTRUMENTATION
+
+#ifdef COLLISION_INSTRUMENTATION
+enum
+{
+    SURFACE_COUNT_TESTED, // reached by a search
+    SURFACE_COUNT_PASSED, // passed the checks, a candidate for a push or the result
+    SURFACE_COUNT_HIT,    // pushed a wall sphere, or was the floor or ceiling found
+    NUM_SURFACE_COUNTS
+};
+
+// Counts of the level surfaces, by index in the surface pool.
+extern u32 gSurfaceHitCounts[SURFACE_POOL_SIZE][NUM_SURFACE_COUNTS];
+#endif
+
+// Numbers of collision queries, by kind.
+struct CollisionCallCounts
+{
+    s16 floor;
+    s16 ceil;
+    s16 wall;
+};
+
+// The most floors of a leaf cell that may overlap a hinted floor, see StaticFloorHint.
+#define FLOOR_HINT_RIVALS_MAX 8
+
+// The callers that keep their own floor hint.
+enum StaticFloorHintSlot
+{
+    FLOOR_HINT_MARIO,
+    FLOOR_HINT_CAMERA,
+    FLOOR_HINT_OBJECTS,
+    NUM_FLOOR_HINTS
+};
+
+/**
+ * The level geometry floor a caller last stood over, see find_floor_in_cells. The
+ * rivals are the other floors of the leaf cell whose bounds overlap the floor's and
+ * that reach up to its lowest point. No other floor of the cell can be over a point
+ * within the floor's bounds as high as the floor.
+ */
+struct StaticFloorHint
+{
+    struct Surface *floor;
+    struct SurfaceNode *staticCell;
+    s16 view;
+    s16 includeIntangible;
+    s16 minX, maxX, minZ, maxZ;
+    s16 numRivals;
+    struct Surface *rivals[FLOOR_HINT_RIVALS_MAX];
+};
+
+/**
+ * The inputs and counters of collision queries. The *_ctx functions only read and
+ * write their context and the level geometry, so queries with different contexts
+ * can run at the same time. The functions without a context use one filled from
+ * the game's globals (gCheckingSurfaceCollisionsForCamera, gCurrentObject, ...),
+ * and add its counters to gNumCalls and gNumFindFloorMisses.
+ */
+struct CollisionQueryContext
+{
+    s8 checkingForCamera;
+    // Reset after every floor query, like gFindFloorIncludeSurfaceIntangible.
+    s8 includeIntangible;
+    struct Object *currentObject;
+    struct Object *marioObject;
+    struct MarioState *marioState;
+    // Object surfaces, shared with the game by default.
+    SpatialPartitionCell (*dynamicPartition)[NUM_CELLS];
+    struct CollisionCallCounts numCalls;
+    s32 numFloorMisses;
+    struct StaticFloorHint floorHints[NUM_FLOOR_HINTS];
+    // The walls find_wall_collisions_multi_ctx collects, kept here to spare the thread's stack.
+    struct SurfaceNode wallCandidates[WALL_CANDIDATES_MAX];
+};
+
+// Collision queries skipped by taking fewer ground quarter steps.
+extern COLLISION_THREAD_LOCAL struct CollisionCallCounts gNumSkippedCalls;
+
+void init_collision_query_context(struct CollisionQueryContext *ctx);
+#ifdef COLLISION_THREADS
+void set_thread_collision_query_context(struct CollisionQueryContext *ctx);
+#endif
 s32 f32_find_wall_collision(f32 *xPtr, f32 *yPtr, f32 *zPtr, f32 offsetY, f32 radius);
+s32 find_wall_collisions_ctx(struct CollisionQueryContext *ctx, struct WallCollisionData *colData);
 s32 find_wall_collisions(struct WallCollisionData *colData);
+s32 find_wall_collisions_multi(struct WallCollisionData **colData, s32 numSpheres);
+s32 find_wall_collisions_multi_ctx(struct CollisionQueryContext *ctx, struct WallCollisionData **colData,
+                                   s32 numSpheres);
+s32 find_walls_in_cells(f32 x1, f32 z1, f32 x2, f32 z2, f32 minY, f32 maxY);
+void add_ceil_margin(f32 *x, f32 *z, Vec3s target1, Vec3s target2, f32 margin);
 f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil);
+f32 find_ceil_ctx(struct CollisionQueryContext *ctx, f32 posX, f32 posY, f32 posZ, struct Surface **pceil);
 f32 find_floor_height_and_data(f32 xPos, f32 yPos, f32 zPos, struct FloorGeometry **floorGeo);
 f32 find_floor_height(f32 x, f32 y, f32 z);
 f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor);
+f32 find_floor_ctx(struct CollisionQueryContext *ctx, f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor);
+f32 find_floor_and_ceil(f32 xPos, f32 yPos, f32 zPos, f32 ceilY, struct Surface **pfloor,
+                        struct Surface **pceil, f32 *pceilHeight);
+f32 find_floor_and_ceil_ctx(struct CollisionQueryContext *ctx, f32 xPos, f32 yPos, f32 zPos, f32 ceilY,
+                            struct Surface **pfloor, struct Surface **pceil, f32 *pceilHeight);
+void clear_static_floor_cache(void);
 f32 find_water_level(f32 x, f32 z);
 f32 find_poison_gas_level(f32 x, f32 z);
+void find_environment_levels(f32 x, f32 z, f32 *waterLevel, f32 *gasLevel);
 void debug_surface_list_info(f32 xPos, f32 zPos);
+#ifdef COLLISION_INSTRUMENTATION
+void clear_surface_hit_counts(void);
+#ifndef TARGET_N64
+s32 write_surface_hit_counts(const char *path);
+s32 write_cell_hit_counts(const char *path);
+#endif
+#endif
 
 #endif // SURFACE_COLLISION_H
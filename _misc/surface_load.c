@@ -0,0 +1,1494 @@
+#include <PR/ultratypes.h>
+
+#include "prevent_bss_reordering.h"
+#include "sm64.h"
+#include "game/ingame_menu.h"
+#include "graph_node.h"
+#include "behavior_script.h"
+#include "behavior_data.h"
+#include "game/memory.h"
+#include "game/object_helpers.h"
+#include "game/macro_special_objects.h"
+#include "surface_collision.h"
+#include "math_util.h"
+#include "game/mario.h"
+#include "game/object_list_processor.h"
+#include "surface_load.h"
+
+s32 unused8038BE90;
+
+/**
+ * Partitions for course and object surfaces. Object surfaces use the fixed
+ * 16x16 cells that each level is split into, course surfaces use leaf cells
+ * of the adaptive partition described by gStaticCells.
+ */
+struct StaticCell gStaticCells[NUM_CELLS][NUM_CELLS];
+SpatialPartitionCell *gStaticSurfacePartition;
+SpatialPartitionCell gDynamicSurfacePartition[NUM_CELLS][NUM_CELLS];
+
+/**
+ * The number of leaf cells in gStaticSurfacePartition. The leaf cells are allocated
+ * for the current area once its layout is known, see alloc_static_leaves.
+ */
+static s32 sNumStaticLeaves;
+
+/**
+ * Layout of the wall bands: band i starts at gWallBandBottom + (i << gWallBandShift).
+ */
+s16 gWallBandBottom = -LEVEL_BOUNDARY_MAX;
+s16 gWallBandShift = 11;
+
+/**
+ * Environment regions overlapping each 16x16 cell, in the order of gEnvironmentRegions.
+ * The regions of cell (cellX, cellZ) are gEnvironmentCellRegions[start..end), where
+ * start and end are gEnvironmentCellStart[cellZ * NUM_CELLS + cellX] and the entry
+ * after it. Only used if gEnvironmentCellsValid is set.
+ */
+s16 gEnvironmentCellStart[NUM_CELLS * NUM_CELLS + 1];
+s16 gEnvironmentCellRegions[ENVIRONMENT_CELL_REGIONS_SIZE];
+s16 gEnvironmentCellsValid;
+
+#ifdef SURFACE_SOA
+/**
+ * The lists of the static partition copied into arrays, see SurfaceArrays.
+ */
+SpatialPartitionRanges *gStaticSurfaceRanges;
+struct SurfaceArrays gStaticSurfaceArrays;
+#endif
+
+/**
+ * Pools of data to contain either surface nodes or surfaces.
+ */
+struct SurfaceNode *sSurfaceNodePool;
+struct Surface *sSurfacePool;
+
+/**
+ * The size of the surface pool (2300).
+ */
+s16 sSurfacePoolSize;
+
+u8 unused8038EEA8[0x30];
+
+/**
+ * Allocate the part of the surface node pool to contain a surface node. Returns
+ * NULL once the pool is used up, walls take a node per wall band so a level that
+ * fit the vanilla pool can run out.
+ */
+static struct SurfaceNode *alloc_surface_node(void) {
+    struct SurfaceNode *node;
+    s32 view;
+
+    if (gSurfaceNodesAllocated >= SURFACE_NODE_POOL_SIZE) {
+        return NULL;
+    }
+
+    node = &sSurfaceNodePool[gSurfaceNodesAllocated];
+    gSurfaceNodesAllocated++;
+
+    for (view = 0; view < NUM_SURFACE_VIEW_CHAINS; view++) {
+        SURFACE_NODE_NEXT(node, view) = NULL;
+    }
+
+    return node;
+}
+
+/**
+ * Allocate the part of the surface pool to contain a surface and
+ * initialize the surface.
+ */
+static struct Surface *alloc_surface(void) {
+
+    struct Surface *surface = &sSurfacePool[gSurfacesAllocated];
+    gSurfacesAllocated++;
+
+    //! A bounds check! If there's more surfaces than the 2300 allowed,
+    //  we, um...
+    // Perhaps originally just debug feedback?
+    if (gSurfacesAllocated >= sSurfacePoolSize) {
+    }
+
+    surface->type = 0;
+    surface->force = 0;
+    surface->flags = 0;
+    surface->room = 0;
+    surface->object = NULL;
+
+    return surface;
+}
+
+/**
+ * Iterates through the given cells, clearing the surfaces.
+ */
+static void clear_spatial_partition(SpatialPartitionCell *cells, s32 numCells) {
+    register s32 i = numCells;
+    register s32 listIndex;
+    register s32 view;
+
+    while (i--) {
+        for (listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+            for (view = 0; view < NUM_SURFACE_VIEW_CHAINS; view++) {
+                SURFACE_NODE_NEXT(&(*cells)[listIndex], view) = NULL;
+            }
+        }
+
+        cells++;
+    }
+}
+
+/**
+ * Clears the static (level) surface partitions for new use.
+ */
+static void clear_static_surfaces(void) {
+    clear_spatial_partition(gStaticSurfacePartition, sNumStaticLeaves);
+}
+
+/**
+ * Returns the wall band containing a height, clamped to the existing bands.
+ */
+static s16 wall_band_index(s16 y) {
+    s32 band = (y - gWallBandBottom) >> gWallBandShift;
+
+    if (band < 0) {
+        band = 0;
+    }
+    if (band > NUM_WALL_BANDS - 1) {
+        band = NUM_WALL_BANDS - 1;
+    }
+
+    return band;
+}
+
+/**
+ * Returns the number of lists of a cell that a surface is added to. Floors and
+ * ceilings go into a single list, walls into every band they overlap.
+ */
+static s32 surface_list_count(struct Surface *surface) {
+    if (surface->normal.y > 0.01 || surface->normal.y < -0.01) {
+        return 1;
+    }
+
+    return wall_band_index(surface->upperY) - wall_band_index(surface->lowerY) + 1;
+}
+
+/**
+ * Add a surface to the correct list of surfaces in a cell, in the chain of every
+ * view that holds it, see SURFACE_VIEW_LINKS.
+ * @param cell The lists of the cell in which the surface resides
+ * @param surface The surface to add
+ */
+static void add_surface_to_cell(struct SurfaceNode *cell, struct Surface *surface) {
+    struct SurfaceNode *newNode;
+    struct SurfaceNode *list;
+    s16 surfacePriority;
+    s16 priorityFlag;
+    s16 sortDir;
+    s16 listIndex;
+    s16 lastListIndex;
+    s16 view;
+
+    // Floors are sorted by their highest point and ceilings by their lowest point,
+    // so queries can stop once no remaining surface can beat the one they found.
+    if (surface->normal.y > 0.01) {
+        listIndex = lastListIndex = SPATIAL_PARTITION_FLOORS;
+        sortDir = 1; // highest to lowest, then insertion order
+        surfacePriority = surface->upperY;
+    } else if (surface->normal.y < -0.01) {
+        listIndex = lastListIndex = SPATIAL_PARTITION_CEILS;
+        sortDir = -1; // lowest to highest, then insertion order
+        surfacePriority = -SURFACE_CEIL_BOTTOM(surface);
+    } else {
+        listIndex = SPATIAL_PARTITION_WALLS + wall_band_index(surface->lowerY);
+        lastListIndex = SPATIAL_PARTITION_WALLS + wall_band_index(surface->upperY);
+        sortDir = 0; // insertion order
+        surfacePriority = 0;
+
+        if (surface->normal.x < -0.707 || surface->normal.x > 0.707) {
+            surface->flags |= SURFACE_FLAG_X_PROJECTION;
+        }
+    }
+
+    for (; listIndex <= lastListIndex; listIndex++) {
+        // Out of nodes, the surface is left out of its remaining lists.
+        newNode = alloc_surface_node();
+        if (newNode == NULL) {
+            return;
+        }
+        newNode->surface = surface;
+
+        for (view = 0; view < NUM_SURFACE_VIEW_CHAINS; view++) {
+            if (!SURFACE_CHAIN_HOLDS(surface, view)) {
+                continue;
+            }
+
+            list = &cell[listIndex];
+
+            // Loop until we find the appropriate place for the surface in the list.
+            while (SURFACE_NODE_NEXT(list, view) != NULL) {
+                if (sortDir > 0) {
+                    priorityFlag = SURFACE_NODE_NEXT(list, view)->surface->upperY;
+                } else if (sortDir < 0) {
+                    priorityFlag = -SURFACE_CEIL_BOTTOM(SURFACE_NODE_NEXT(list, view)->surface);
+                } else {
+                    priorityFlag = 0;
+                }
+
+                if (surfacePriority > priorityFlag) {
+                    break;
+                }
+
+                list = SURFACE_NODE_NEXT(list, view);
+            }
+
+            SURFACE_NODE_NEXT(newNode, view) = SURFACE_NODE_NEXT(list, view);
+            SURFACE_NODE_NEXT(list, view) = newNode;
+        }
+    }
+}
+
+/**
+ * Returns the lowest of three values.
+ */
+static s16 min_3(s16 a0, s16 a1, s16 a2) {
+    if (a1 < a0) {
+        a0 = a1;
+    }
+
+    if (a2 < a0) {
+        a0 = a2;
+    }
+
+    return a0;
+}
+
+/**
+ * Returns the highest of three values.
+ */
+static s16 max_3(s16 a0, s16 a1, s16 a2) {
+    if (a1 > a0) {
+        a0 = a1;
+    }
+
+    if (a2 > a0) {
+        a0 = a2;
+    }
+
+    return a0;
+}
+
+/**
+ * Every level is split into cells of surfaces (to limit computing
+ * time). This function determines the lower cell for a given x/z position.
+ * @param coord The coordinate to test
+ * @param cellSize The size of the cells, CELL_SIZE or a leaf cell size
+ */
+static s16 lower_cell_index(s16 coord, s16 cellSize) {
+    s16 index;
+
+    // Move from range [-0x2000, 0x2000) to [0, 0x4000)
+    coord += LEVEL_BOUNDARY_MAX;
+    if (coord < 0) {
+        coord = 0;
+    }
+
+    index = coord / cellSize;
+
+    // Include extra cell if close to boundary
+    //! Some wall checks are larger than the buffer, meaning wall checks can
+    //  miss walls that are near a cell border.
+    if (coord % cellSize < 50) {
+        index -= 1;
+    }
+
+    if (index < 0) {
+        index = 0;
+    }
+
+    // Potentially past the last cell, but since the upper index is clamped, not exploitable
+    return index;
+}
+
+/**
+ * Every level is split into cells of surfaces (to limit computing
+ * time). This function determines the upper cell for a given x/z position.
+ * @param coord The coordinate to test
+ * @param cellSize The size of the cells, CELL_SIZE or a leaf cell size
+ * @param maxIndex The highest cell index along the axis
+ */
+static s16 upper_cell_index(s16 coord, s16 cellSize, s16 maxIndex) {
+    s16 index;
+
+    // Move from range [-0x2000, 0x2000) to [0, 0x4000)
+    coord += LEVEL_BOUNDARY_MAX;
+    if (coord < 0) {
+        coord = 0;
+    }
+
+    // [0, maxIndex]
+    index = coord / cellSize;
+
+    // Include extra cell if close to boundary
+    //! Some wall checks are larger than the buffer, meaning wall checks can
+    //  miss walls that are near a cell border.
+    if (coord % cellSize > cellSize - 50) {
+        index += 1;
+    }
+
+    if (index > maxIndex) {
+        index = maxIndex;
+    }
+
+    // Potentially < 0, but since lower index is >= 0, not exploitable
+    return index;
+}
+
+/**
+ * Every level is split into 16x16 cells, this takes an object surface, finds
+ * the appropriate cells (with a buffer), and adds the surface to those
+ * cells.
+ * @param surface The surface to check
+ */
+static void add_dynamic_surface(struct Surface *surface) {
+    s16 minX, minZ, maxX, maxZ;
+
+    s16 minCellX, minCellZ, maxCellX, maxCellZ;
+
+    s16 cellZ, cellX;
+
+    minX = min_3(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0]);
+    minZ = min_3(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2]);
+    maxX = max_3(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0]);
+    maxZ = max_3(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2]);
+
+    minCellX = lower_cell_index(minX, CELL_SIZE);
+    maxCellX = upper_cell_index(maxX, CELL_SIZE, NUM_CELLS_INDEX);
+    minCellZ = lower_cell_index(minZ, CELL_SIZE);
+    maxCellZ = upper_cell_index(maxZ, CELL_SIZE, NUM_CELLS_INDEX);
+
+    for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+        for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+            add_surface_to_cell(gDynamicSurfacePartition[cellZ][cellX], surface);
+        }
+    }
+}
+
+/**
+ * Finds the leaf cells of the static partition that a level surface overlaps
+ * (with the same buffer as the 16x16 cells) and adds the surface to them.
+ * @param surface The surface to check
+ * @param insert If FALSE, only count the leaf cells without adding the surface
+ * @return The number of surface nodes the surface takes up
+ */
+static s32 add_static_surface(struct Surface *surface, s32 insert) {
+    s16 minX, minZ, maxX, maxZ;
+    s16 cellX, cellZ;
+    s16 leafX, leafZ;
+    s16 minLeafX, minLeafZ, maxLeafX, maxLeafZ;
+    s16 leafSize, leafMaxIndex;
+    s16 leafBuffer = 0;
+    struct StaticCell *cell;
+    s32 numNodes = 0;
+
+    minX = min_3(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0]);
+    minZ = min_3(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2]);
+    maxX = max_3(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0]);
+    maxZ = max_3(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2]);
+
+    // Wall checks, and the rounded edges of walls, reach up to the maximum collision
+    // radius of 200, past the 50 unit buffer. The 16x16 cell keeps such walls anyway,
+    // so its leaf cells must too.
+    if (surface->normal.y <= 0.01 && surface->normal.y >= -0.01) {
+        leafBuffer = 200 - 50;
+    }
+
+    for (cellZ = lower_cell_index(minZ, CELL_SIZE);
+         cellZ <= upper_cell_index(maxZ, CELL_SIZE, NUM_CELLS_INDEX); cellZ++) {
+        for (cellX = lower_cell_index(minX, CELL_SIZE);
+             cellX <= upper_cell_index(maxX, CELL_SIZE, NUM_CELLS_INDEX); cellX++) {
+            cell = &gStaticCells[cellZ][cellX];
+            leafSize = CELL_SIZE >> cell->subdivision;
+            leafMaxIndex = (NUM_CELLS << cell->subdivision) - 1;
+
+            // Leaf indices are level-wide, so clamp them to the leaves of this cell.
+            minLeafX = lower_cell_index(minX - leafBuffer, leafSize) - (cellX << cell->subdivision);
+            maxLeafX = upper_cell_index(maxX + leafBuffer, leafSize, leafMaxIndex) - (cellX << cell->subdivision);
+            minLeafZ = lower_cell_index(minZ - leafBuffer, leafSize) - (cellZ << cell->subdivision);
+            maxLeafZ = upper_cell_index(maxZ + leafBuffer, leafSize, leafMaxIndex) - (cellZ << cell->subdivision);
+
+            if (minLeafX < 0) {
+                minLeafX = 0;
+            }
+            if (minLeafZ < 0) {
+                minLeafZ = 0;
+            }
+            if (maxLeafX > (1 << cell->subdivision) - 1) {
+                maxLeafX = (1 << cell->subdivision) - 1;
+            }
+            if (maxLeafZ > (1 << cell->subdivision) - 1) {
+                maxLeafZ = (1 << cell->subdivision) - 1;
+            }
+
+            for (leafZ = minLeafZ; leafZ <= maxLeafZ; leafZ++) {
+                for (leafX = minLeafX; leafX <= maxLeafX; leafX++) {
+                    if (insert) {
+                        add_surface_to_cell(gStaticSurfacePartition[cell->firstLeaf
+                                                                    + (leafZ << cell->subdivision)
+                                                                    + leafX],
+                                            surface);
+                    }
+                    numNodes += surface_list_count(surface);
+                }
+            }
+        }
+    }
+
+    return numNodes;
+}
+
+#ifdef SURFACE_SOA
+/**
+ * Copies every list of the static partition's leaf cells into gStaticSurfaceArrays,
+ * in list order and once per view, and records where each list starts.
+ */
+static void build_static_surface_arrays(s32 numLeaves) {
+    struct SurfaceArrays *arrays = &gStaticSurfaceArrays;
+    struct SurfaceArrayRange *range;
+    struct SurfaceNode *node;
+    struct Surface *surface;
+    s32 leaf, view, listIndex;
+    s32 count = 0;
+
+    for (leaf = 0; leaf < numLeaves; leaf++) {
+        for (view = 0; view < NUM_SURFACE_VIEWS; view++) {
+            for (listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+                range = &gStaticSurfaceRanges[leaf][view][listIndex];
+                range->start = count;
+
+                for (node = SURFACE_NODE_NEXT(&gStaticSurfacePartition[leaf][listIndex], view); node != NULL;
+                     node = SURFACE_NODE_NEXT(node, view)) {
+                    surface = node->surface;
+                    if (SURFACE_CHAIN_SKIPS(surface, view)) {
+                        continue;
+                    }
+
+                    // Ceiling lists are searched by their bottom instead, see SURFACE_CEIL_BOTTOM.
+                    arrays->lowerY[count] = listIndex == SPATIAL_PARTITION_CEILS ? SURFACE_CEIL_BOTTOM(surface)
+                                                                                 : surface->lowerY;
+                    arrays->upperY[count] = surface->upperY;
+                    arrays->normalX[count] = surface->normal.x;
+                    arrays->normalY[count] = surface->normal.y;
+                    arrays->normalZ[count] = surface->normal.z;
+                    arrays->originOffset[count] = surface->originOffset;
+                    arrays->surface[count] = surface;
+                    count++;
+                }
+
+                range->count = count - range->start;
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * Picks the subdivision of every static cell from its surface count, never
+ * splitting further than maxSubdivision, and lays out the leaf cells.
+ * @return The number of leaf cells needed
+ */
+static s32 assign_static_leaves(s16 counts[NUM_CELLS][NUM_CELLS], s16 maxSubdivision) {
+    s32 cellX, cellZ;
+    s32 numLeaves = 0;
+    struct StaticCell *cell;
+
+    for (cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+        for (cellX = 0; cellX < NUM_CELLS; cellX++) {
+            cell = &gStaticCells[cellZ][cellX];
+
+            // Each subdivision splits the cell (and its surfaces) into four.
+            cell->subdivision = 0;
+            while (cell->subdivision < maxSubdivision
+                   && (counts[cellZ][cellX] >> (2 * cell->subdivision)) > STATIC_CELL_SURFACE_LIMIT) {
+                cell->subdivision++;
+            }
+
+            cell->firstLeaf = numLeaves;
+            numLeaves += 1 << (2 * cell->subdivision);
+        }
+    }
+
+    return numLeaves;
+}
+
+/**
+ * Returns the number of surface nodes the static partition takes with the current
+ * leaf layout and wall bands.
+ */
+static s32 count_static_nodes(void) {
+    s32 numNodes = 0;
+    s32 i;
+
+    for (i = 0; i < gSurfacesAllocated; i++) {
+        numNodes += add_static_surface(&sSurfacePool[i], FALSE);
+    }
+
+    return numNodes;
+}
+
+/**
+ * Spreads the wall bands evenly over the height range of the level's walls.
+ * The band height is rounded up to a power of two so bands can be found with a shift.
+ */
+static void assign_wall_bands(void) {
+    s32 minY = LEVEL_BOUNDARY_MAX;
+    s32 maxY = -LEVEL_BOUNDARY_MAX;
+    s32 i;
+
+    for (i = 0; i < gSurfacesAllocated; i++) {
+        struct Surface *surface = &sSurfacePool[i];
+
+        if (surface->normal.y <= 0.01 && surface->normal.y >= -0.01) {
+            if (surface->lowerY < minY) {
+                minY = surface->lowerY;
+            }
+            if (surface->upperY > maxY) {
+                maxY = surface->upperY;
+            }
+        }
+    }
+
+    if (minY > maxY) {
+        minY = maxY = 0;
+    }
+
+    gWallBandBottom = minY;
+    gWallBandShift = 0;
+    while ((NUM_WALL_BANDS << gWallBandShift) <= maxY - minY) {
+        gWallBandShift++;
+    }
+}
+
+#if WALL_ROUTINE_TIER == WALL_TIER_HYBRID
+// The vertices of each edge of a wall, in the order of SURFACE_FLAG_CONVEX_EDGE_1_2..2_3.
+static const s8 sWallEdgeVertices[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+
+/**
+ * Clears the convex flag of every edge of wall that other shares and continues flat
+ * or bends in front of, so that the face of other pushes where the edge would. Only
+ * done if every view colliding with wall also collides with other.
+ */
+static void clear_covered_wall_edges(struct Surface *wall, struct Surface *other) {
+    static const s8 edgeFlags[3] = { SURFACE_FLAG_CONVEX_EDGE_1_2, SURFACE_FLAG_CONVEX_EDGE_1_3,
+                                     SURFACE_FLAG_CONVEX_EDGE_2_3 };
+    s16 *vertices[3];
+    s16 *otherVertices[3];
+    s16 *a, *b, *c, *d, *third;
+    s32 edge, otherEdge, view;
+
+    for (view = 0; view < NUM_SURFACE_VIEWS; view++) {
+        if (SURFACE_IS_IN_VIEW(wall, view) && !SURFACE_IS_IN_VIEW(other, view)) {
+            return;
+        }
+    }
+
+    vertices[0] = wall->vertex1;
+    vertices[1] = wall->vertex2;
+    vertices[2] = wall->vertex3;
+    otherVertices[0] = other->vertex1;
+    otherVertices[1] = other->vertex2;
+    otherVertices[2] = other->vertex3;
+
+    for (edge = 0; edge < 3; edge++) {
+        a = vertices[sWallEdgeVertices[edge][0]];
+        b = vertices[sWallEdgeVertices[edge][1]];
+
+        for (otherEdge = 0; otherEdge < 3; otherEdge++) {
+            c = otherVertices[sWallEdgeVertices[otherEdge][0]];
+            d = otherVertices[sWallEdgeVertices[otherEdge][1]];
+
+            if (!(a[0] == c[0] && a[1] == c[1] && a[2] == c[2] && b[0] == d[0] && b[1] == d[1] && b[2] == d[2])
+                && !(a[0] == d[0] && a[1] == d[1] && a[2] == d[2] && b[0] == c[0] && b[1] == c[1] && b[2] == c[2])) {
+                continue;
+            }
+
+            // The vertex of other off the shared edge, behind wall if the edge sticks out.
+            // Less than a unit behind is taken as flat.
+            third = otherVertices[3 - sWallEdgeVertices[otherEdge][0] - sWallEdgeVertices[otherEdge][1]];
+            if (wall->normal.x * third[0] + wall->normal.y * third[1] + wall->normal.z * third[2]
+                    + wall->originOffset > -1.0f) {
+                wall->flags &= ~edgeFlags[edge];
+            }
+        }
+    }
+}
+
+/**
+ * Hashes an edge of a wall by its two vertices, the same for either direction, so
+ * the walls sharing the edge land in the same bucket.
+ */
+static u32 hash_wall_edge(struct Surface *wall, s32 edge) {
+    s16 *vertices[3];
+    s16 *a, *b;
+    u32 hash;
+
+    vertices[0] = wall->vertex1;
+    vertices[1] = wall->vertex2;
+    vertices[2] = wall->vertex3;
+    a = vertices[sWallEdgeVertices[edge][0]];
+    b = vertices[sWallEdgeVertices[edge][1]];
+
+    hash = ((u16) a[0] + (u16) b[0]) * 0x9E3779B1u;
+    hash ^= ((u16) a[1] + (u16) b[1]) * 0x85EBCA77u;
+    hash ^= ((u16) a[2] + (u16) b[2]) * 0xC2B2AE3Du;
+    hash ^= hash >> 15;
+    hash *= 0x2C1B3C6Du;
+    hash ^= hash >> 12;
+    return hash;
+}
+
+/**
+ * Marks the edges of the static walls that stick out for WALL_TIER_HYBRID. An edge is
+ * convex unless another wall covers it, see clear_covered_wall_edges. The edges are
+ * chained into buckets by hash_wall_edge, and only walls with edges in the same bucket
+ * are compared, instead of every pair of walls in a wall list. The table is taken from
+ * the main pool while marking. Without room for it, every edge is left convex, which
+ * pushes like WALL_TIER_FULL.
+ */
+static void mark_convex_wall_edges(void) {
+    s32 *buckets;
+    s32 *nextEdge;
+    s32 numEdges = 0;
+    s32 numBuckets = 1;
+    s32 bucket, edge, otherEdge;
+    s32 i;
+
+    for (i = 0; i < gSurfacesAllocated; i++) {
+        struct Surface *surface = &sSurfacePool[i];
+
+        if (surface->normal.y <= 0.01 && surface->normal.y >= -0.01) {
+            surface->flags |= SURFACE_FLAGS_CONVEX_EDGES;
+            numEdges += 3;
+        }
+    }
+
+    while (numBuckets < numEdges) {
+        numBuckets <<= 1;
+    }
+
+    // Edge i * 3 + n is edge n of sSurfacePool[i].
+    buckets = main_pool_alloc((numBuckets + gSurfacesAllocated * 3) * sizeof(s32), MEMORY_POOL_RIGHT);
+    if (buckets == NULL) {
+        return;
+    }
+    nextEdge = buckets + numBuckets;
+
+    for (bucket = 0; bucket < numBuckets; bucket++) {
+        buckets[bucket] = -1;
+    }
+
+    for (i = 0; i < gSurfacesAllocated; i++) {
+        struct Surface *surface = &sSurfacePool[i];
+
+        if (surface->normal.y <= 0.01 && surface->normal.y >= -0.01) {
+            for (edge = i * 3; edge < i * 3 + 3; edge++) {
+                bucket = hash_wall_edge(surface, edge - i * 3) & (numBuckets - 1);
+                nextEdge[edge] = buckets[bucket];
+                buckets[bucket] = edge;
+            }
+        }
+    }
+
+    for (bucket = 0; bucket < numBuckets; bucket++) {
+        for (edge = buckets[bucket]; edge >= 0; edge = nextEdge[edge]) {
+            for (otherEdge = nextEdge[edge]; otherEdge >= 0; otherEdge = nextEdge[otherEdge]) {
+                if (edge / 3 != otherEdge / 3) {
+                    clear_covered_wall_edges(&sSurfacePool[edge / 3], &sSurfacePool[otherEdge / 3]);
+                    clear_covered_wall_edges(&sSurfacePool[otherEdge / 3], &sSurfacePool[edge / 3]);
+                }
+            }
+        }
+    }
+
+    main_pool_free(buckets);
+}
+#endif
+
+/**
+ * The main pool memory taken by numLeaves leaf cells, with their array ranges.
+ */
+static u32 static_leaves_size(s32 numLeaves) {
+#ifdef SURFACE_SOA
+    return ALIGN16(numLeaves * sizeof(SpatialPartitionCell)) + numLeaves * sizeof(SpatialPartitionRanges);
+#else
+    return numLeaves * sizeof(SpatialPartitionCell);
+#endif
+}
+
+/**
+ * Frees the leaf cells of the previous area. Like any main pool block, this also frees
+ * what was allocated on the right after them, which while a level runs is only ever
+ * the temporary buffers of segment loads.
+ */
+static void free_static_leaves(void) {
+    if (gStaticSurfacePartition != NULL) {
+        main_pool_free(gStaticSurfacePartition);
+        gStaticSurfacePartition = NULL;
+    }
+    sNumStaticLeaves = 0;
+}
+
+/**
+ * Allocates the numLeaves leaf cells of the area from the right of the main pool
+ * and clears them.
+ */
+static void alloc_static_leaves(s32 numLeaves) {
+    gStaticSurfacePartition = main_pool_alloc(static_leaves_size(numLeaves), MEMORY_POOL_RIGHT);
+#ifdef SURFACE_SOA
+    gStaticSurfaceRanges = (SpatialPartitionRanges *) ((u8 *) gStaticSurfacePartition
+                                                       + ALIGN16(numLeaves * sizeof(SpatialPartitionCell)));
+#endif
+    sNumStaticLeaves = numLeaves;
+    clear_static_surfaces();
+}
+
+/**
+ * Builds the static partition out of all surfaces loaded so far. Dense cells
+ * are subdivided as long as the leaf cells fit in the main pool and the surface
+ * nodes in their budget, otherwise the finest subdivision is lowered until they do.
+ * Only the leaf cells of the chosen layout are allocated.
+ */
+static void build_static_partition(void) {
+    s16 counts[NUM_CELLS][NUM_CELLS];
+    s16 maxSubdivision = STATIC_CELL_MAX_SUBDIVISION;
+    s32 numLeaves;
+    s32 i;
+
+    free_static_leaves();
+    assign_wall_bands();
+
+    // Count the surfaces per cell, with the regular 16x16 layout.
+    for (i = 0; i < NUM_CELLS * NUM_CELLS; i++) {
+        counts[i / NUM_CELLS][i % NUM_CELLS] = 0;
+    }
+
+    for (i = 0; i < gSurfacesAllocated; i++) {
+        s16 cellX, cellZ;
+        struct Surface *surface = &sSurfacePool[i];
+        s16 minX = min_3(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0]);
+        s16 minZ = min_3(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2]);
+        s16 maxX = max_3(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0]);
+        s16 maxZ = max_3(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2]);
+
+        for (cellZ = lower_cell_index(minZ, CELL_SIZE);
+             cellZ <= upper_cell_index(maxZ, CELL_SIZE, NUM_CELLS_INDEX); cellZ++) {
+            for (cellX = lower_cell_index(minX, CELL_SIZE);
+                 cellX <= upper_cell_index(maxX, CELL_SIZE, NUM_CELLS_INDEX); cellX++) {
+                counts[cellZ][cellX]++;
+            }
+        }
+    }
+
+    while (maxSubdivision > 0) {
+        numLeaves = assign_static_leaves(counts, maxSubdivision);
+        if (ALIGN16(static_leaves_size(numLeaves)) <= main_pool_available()
+            && count_static_nodes() <= STATIC_SURFACE_NODE_BUDGET) {
+            break;
+        }
+
+        maxSubdivision--;
+    }
+
+    if (maxSubdivision == 0) {
+        numLeaves = assign_static_leaves(counts, 0);
+
+        // Walls take a node per band they overlap. If the 16x16 cells still need more
+        // nodes than the budget, the bands are doubled in height until they fit, at
+        // most until all walls share one list as in vanilla.
+        while (count_static_nodes() > STATIC_SURFACE_NODE_BUDGET && gWallBandShift < 16) {
+            gWallBandShift++;
+        }
+    }
+
+    alloc_static_leaves(numLeaves);
+
+    for (i = 0; i < gSurfacesAllocated; i++) {
+        add_static_surface(&sSurfacePool[i], TRUE);
+    }
+
+#if WALL_ROUTINE_TIER == WALL_TIER_HYBRID
+    mark_convex_wall_edges();
+#endif
+#ifdef SURFACE_SOA
+    build_static_surface_arrays(numLeaves);
+#endif
+}
+
+static void stub_surface_load_1(void) {
+}
+
+/**
+ * Initializes a Surface struct using the given vertex data
+ * @param vertexData The raw data containing vertex positions
+ * @param vertexIndices Helper which tells positions in vertexData to start reading vertices
+ */
+static struct Surface *read_surface_data(s16 *vertexData, s16 **vertexIndices) {
+    struct Surface *surface;
+    register s32 x1, y1, z1;
+    register s32 x2, y2, z2;
+    register s32 x3, y3, z3;
+    s32 maxY, minY;
+    f32 nx, ny, nz;
+    f32 mag;
+    s16 offset1, offset2, offset3;
+
+    offset1 = 3 * (*vertexIndices)[0];
+    offset2 = 3 * (*vertexIndices)[1];
+    offset3 = 3 * (*vertexIndices)[2];
+
+    x1 = *(vertexData + offset1 + 0);
+    y1 = *(vertexData + offset1 + 1);
+    z1 = *(vertexData + offset1 + 2);
+
+    x2 = *(vertexData + offset2 + 0);
+    y2 = *(vertexData + offset2 + 1);
+    z2 = *(vertexData + offset2 + 2);
+
+    x3 = *(vertexData + offset3 + 0);
+    y3 = *(vertexData + offset3 + 1);
+    z3 = *(vertexData + offset3 + 2);
+
+    // (v2 - v1) x (v3 - v2)
+    nx = (y2 - y1) * (z3 - z2) - (z2 - z1) * (y3 - y2);
+    ny = (z2 - z1) * (x3 - x2) - (x2 - x1) * (z3 - z2);
+    nz = (x2 - x1) * (y3 - y2) - (y2 - y1) * (x3 - x2);
+    mag = sqrtf(nx * nx + ny * ny + nz * nz);
+
+    // Could have used min_3 and max_3 for this...
+    minY = y1;
+    if (y2 < minY) {
+        minY = y2;
+    }
+    if (y3 < minY) {
+        minY = y3;
+    }
+
+    maxY = y1;
+    if (y2 > maxY) {
+        maxY = y2;
+    }
+    if (y3 > maxY) {
+        maxY = y3;
+    }
+
+    // Checking to make sure no DIV/0
+    if (mag < 0.0001) {
+        return NULL;
+    }
+    mag = (f32)(1.0 / mag);
+    nx *= mag;
+    ny *= mag;
+    nz *= mag;
+
+    surface = alloc_surface();
+
+    surface->vertex1[0] = x1;
+    surface->vertex2[0] = x2;
+    surface->vertex3[0] = x3;
+
+    surface->vertex1[1] = y1;
+    surface->vertex2[1] = y2;
+    surface->vertex3[1] = y3;
+
+    surface->vertex1[2] = z1;
+    surface->vertex2[2] = z2;
+    surface->vertex3[2] = z3;
+
+    surface->normal.x = nx;
+    surface->normal.y = ny;
+    surface->normal.z = nz;
+
+    surface->originOffset = -(nx * x1 + ny * y1 + nz * z1);
+
+    surface->lowerY = minY - 5;
+    surface->upperY = maxY + 5;
+
+    return surface;
+}
+
+/**
+ * Returns whether a surface has exertion/moves Mario
+ * based on the surface type.
+ */
+static s32 surface_has_force(s16 surfaceType) {
+    s32 hasForce = FALSE;
+
+    switch (surfaceType) {
+        case SURFACE_0004: // Unused
+        case SURFACE_FLOWING_WATER:
+        case SURFACE_DEEP_MOVING_QUICKSAND:
+        case SURFACE_SHALLOW_MOVING_QUICKSAND:
+        case SURFACE_MOVING_QUICKSAND:
+        case SURFACE_HORIZONTAL_WIND:
+        case SURFACE_INSTANT_MOVING_QUICKSAND:
+            hasForce = TRUE;
+            break;
+
+        default:
+            break;
+    }
+    return hasForce;
+}
+
+/**
+ * Returns whether a surface should have the
+ * SURFACE_FLAG_NO_CAM_COLLISION flag.
+ */
+static s32 surf_has_no_cam_collision(s16 surfaceType) {
+    s32 flags = 0;
+
+    switch (surfaceType) {
+        case SURFACE_NO_CAM_COLLISION:
+        case SURFACE_NO_CAM_COLLISION_77: // Unused
+        case SURFACE_NO_CAM_COL_VERY_SLIPPERY:
+        case SURFACE_SWITCH:
+            flags = SURFACE_FLAG_NO_CAM_COLLISION;
+            break;
+
+        default:
+            break;
+    }
+
+    return flags;
+}
+
+/**
+ * Stores the yaw a wall faces, see SURFACE_WALL_YAW, so the step code doesn't
+ * compute it from the normal on every quarter step.
+ */
+static void set_wall_yaw(struct Surface *surface) {
+    if (surface->normal.y <= 0.01 && surface->normal.y >= -0.01) {
+        SURFACE_WALL_YAW(surface) = atan2s(surface->normal.z, surface->normal.x);
+    }
+}
+
+/**
+ * Stores the lowest height a ceiling can be found at, see SURFACE_CEIL_BOTTOM. The
+ * ceiling searches test against the triangle with the corners moved by the margin,
+ * so the plane is lowest at one of the moved corners. Ceilings that are not steep
+ * keep lowerY, which is 5 units below their lowest vertex.
+ */
+static void set_ceil_bottom(struct Surface *surface) {
+    s16 *vertices[3];
+    f32 x, z, height;
+    s32 bottom = surface->lowerY;
+    s32 i;
+
+    if (surface->normal.y >= -0.01) {
+        return;
+    }
+
+    vertices[0] = surface->vertex1;
+    vertices[1] = surface->vertex2;
+    vertices[2] = surface->vertex3;
+
+    for (i = 0; i < 3; i++) {
+        x = vertices[i][0];
+        z = vertices[i][2];
+        if (surface->type != SURFACE_HANGABLE) {
+            add_ceil_margin(&x, &z, vertices[(i + 1) % 3], vertices[(i + 2) % 3], CEIL_MARGIN);
+        }
+
+        height = -(x * surface->normal.x + surface->normal.z * z + surface->originOffset) / surface->normal.y;
+
+        // At least a unit lower, for the rounding of the searches' heights.
+        if (height - 1.0f < bottom) {
+            bottom = height < -0x7FFE ? -0x8000 : (s32) height - 2;
+        }
+    }
+
+    SURFACE_CEIL_BOTTOM(surface) = bottom;
+}
+
+/**
+ * Load in the surfaces for a given surface type. This includes setting the flags,
+ * exertion, and room. The surfaces are added to the static partition once the
+ * whole level is loaded.
+ */
+static void load_static_surfaces(s16 **data, s16 *vertexData, s16 surfaceType, s8 **surfaceRooms) {
+    s32 i;
+    s32 numSurfaces;
+    struct Surface *surface;
+    s8 room = 0;
+    s16 hasForce = surface_has_force(surfaceType);
+    s16 flags = surf_has_no_cam_collision(surfaceType);
+
+    numSurfaces = *(*data);
+    *data += 1;
+
+    for (i = 0; i < numSurfaces; i++) {
+        if (*surfaceRooms != NULL) {
+            room = *(*surfaceRooms);
+            *surfaceRooms += 1;
+        }
+
+        surface = read_surface_data(vertexData, data);
+        if (surface != NULL) {
+            surface->room = room;
+            surface->type = surfaceType;
+            surface->flags = (s8) flags;
+
+            if (hasForce) {
+                surface->force = *(*data + 3);
+            } else {
+                surface->force = 0;
+            }
+            set_wall_yaw(surface);
+            set_ceil_bottom(surface);
+        }
+
+        *data += 3;
+        if (hasForce) {
+            *data += 1;
+        }
+    }
+}
+
+/**
+ * Read the data for vertices for reference by triangles.
+ */
+static s16 *read_vertex_data(s16 **data) {
+    s32 numVertices;
+    UNUSED s16 unused1[3];
+    UNUSED s16 unused2[3];
+    s16 *vertexData;
+
+    numVertices = *(*data);
+    (*data)++;
+
+    vertexData = *data;
+    *data += 3 * numVertices;
+
+    return vertexData;
+}
+
+/**
+ * Loads in special environmental regions, such as water, poison gas, and JRB fog.
+ */
+static void load_environmental_regions(s16 **data) {
+    s32 numRegions;
+    s32 i;
+
+    gEnvironmentRegions = *data;
+    numRegions = *(*data)++;
+
+    if (numRegions > 20) {
+    }
+
+    for (i = 0; i < numRegions; i++) {
+        UNUSED s16 val, loX, loZ, hiX, hiZ;
+        s16 height;
+
+        val = *(*data)++;
+
+        loX = *(*data)++;
+        hiX = *(*data)++;
+        loZ = *(*data)++;
+        hiZ = *(*data)++;
+
+        height = *(*data)++;
+
+        gEnvironmentLevels[i] = height;
+    }
+}
+
+/**
+ * Finds the range of cells that an environment region's bounds overlap. Returns FALSE
+ * if the region is empty.
+ */
+static s32 get_environment_region_cells(s16 *region, s16 *minCellX, s16 *minCellZ, s16 *maxCellX,
+                                        s16 *maxCellZ) {
+    s32 loX = region[1];
+    s32 loZ = region[2];
+    s32 hiX = region[3];
+    s32 hiZ = region[4];
+
+    if (loX >= hiX || loZ >= hiZ) {
+        return FALSE;
+    }
+    if (hiX <= -LEVEL_BOUNDARY_MAX || loX >= LEVEL_BOUNDARY_MAX) {
+        return FALSE;
+    }
+    if (hiZ <= -LEVEL_BOUNDARY_MAX || loZ >= LEVEL_BOUNDARY_MAX) {
+        return FALSE;
+    }
+
+    *minCellX = (loX > -LEVEL_BOUNDARY_MAX) ? (loX + LEVEL_BOUNDARY_MAX) / CELL_SIZE : 0;
+    *minCellZ = (loZ > -LEVEL_BOUNDARY_MAX) ? (loZ + LEVEL_BOUNDARY_MAX) / CELL_SIZE : 0;
+    *maxCellX = (hiX < LEVEL_BOUNDARY_MAX) ? (hiX + LEVEL_BOUNDARY_MAX) / CELL_SIZE : NUM_CELLS_INDEX;
+    *maxCellZ = (hiZ < LEVEL_BOUNDARY_MAX) ? (hiZ + LEVEL_BOUNDARY_MAX) / CELL_SIZE : NUM_CELLS_INDEX;
+
+    return TRUE;
+}
+
+/**
+ * Buckets the environment regions into the 16x16 cells, so that water and gas
+ * lookups only check the regions of one cell. If there are too many entries,
+ * the lookups check every region instead.
+ */
+static void build_environment_cells(void) {
+    s16 counts[NUM_CELLS * NUM_CELLS];
+    s16 minCellX, minCellZ, maxCellX, maxCellZ;
+    s16 cellX, cellZ;
+    s16 *region;
+    s32 numRegions;
+    s32 numEntries = 0;
+    s32 i, cell;
+
+    gEnvironmentCellsValid = FALSE;
+
+    if (gEnvironmentRegions == NULL) {
+        return;
+    }
+
+    numRegions = gEnvironmentRegions[0];
+
+    for (cell = 0; cell < NUM_CELLS * NUM_CELLS; cell++) {
+        counts[cell] = 0;
+    }
+
+    for (i = 0, region = &gEnvironmentRegions[1]; i < numRegions; i++, region += 6) {
+        if (get_environment_region_cells(region, &minCellX, &minCellZ, &maxCellX, &maxCellZ)) {
+            for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+                for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+                    counts[cellZ * NUM_CELLS + cellX]++;
+                    numEntries++;
+                }
+            }
+        }
+    }
+
+    if (numEntries > ENVIRONMENT_CELL_REGIONS_SIZE) {
+        return;
+    }
+
+    // Entries are written from the end of each cell's range, leaving the start behind.
+    gEnvironmentCellStart[0] = 0;
+    for (cell = 0; cell < NUM_CELLS * NUM_CELLS; cell++) {
+        gEnvironmentCellStart[cell + 1] = gEnvironmentCellStart[cell] + counts[cell];
+        counts[cell] = gEnvironmentCellStart[cell + 1];
+    }
+
+    for (i = numRegions - 1; i >= 0; i--) {
+        region = &gEnvironmentRegions[1 + 6 * i];
+
+        if (get_environment_region_cells(region, &minCellX, &minCellZ, &maxCellX, &maxCellZ)) {
+            for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+                for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+                    gEnvironmentCellRegions[--counts[cellZ * NUM_CELLS + cellX]] = i;
+                }
+            }
+        }
+    }
+
+    gEnvironmentCellsValid = TRUE;
+}
+
+/**
+ * Allocate some of the main pool for surfaces (2300 surf) and for surface nodes (7000 nodes).
+ * The leaf cells of the static partition are allocated by each area, the previous level's
+ * were freed with the rest of its main pool state.
+ */
+void alloc_surface_pools(void) {
+    sSurfacePoolSize = SURFACE_POOL_SIZE;
+    sSurfaceNodePool = main_pool_alloc(SURFACE_NODE_POOL_SIZE * sizeof(struct SurfaceNode), MEMORY_POOL_LEFT);
+    sSurfacePool = main_pool_alloc(sSurfacePoolSize * sizeof(struct Surface), MEMORY_POOL_LEFT);
+    gStaticSurfacePartition = NULL;
+    sNumStaticLeaves = 0;
+
+#ifdef SURFACE_SOA
+    gStaticSurfaceArrays.lowerY = main_pool_alloc(SURFACE_ARRAY_SIZE * sizeof(s16), MEMORY_POOL_LEFT);
+    gStaticSurfaceArrays.upperY = main_pool_alloc(SURFACE_ARRAY_SIZE * sizeof(s16), MEMORY_POOL_LEFT);
+    gStaticSurfaceArrays.normalX = main_pool_alloc(SURFACE_ARRAY_SIZE * sizeof(f32), MEMORY_POOL_LEFT);
+    gStaticSurfaceArrays.normalY = main_pool_alloc(SURFACE_ARRAY_SIZE * sizeof(f32), MEMORY_POOL_LEFT);
+    gStaticSurfaceArrays.normalZ = main_pool_alloc(SURFACE_ARRAY_SIZE * sizeof(f32), MEMORY_POOL_LEFT);
+    gStaticSurfaceArrays.originOffset = main_pool_alloc(SURFACE_ARRAY_SIZE * sizeof(f32), MEMORY_POOL_LEFT);
+    gStaticSurfaceArrays.surface = main_pool_alloc(SURFACE_ARRAY_SIZE * sizeof(struct Surface *), MEMORY_POOL_LEFT);
+#endif
+
+    gCCMEnteredSlide = 0;
+    reset_red_coins_collected();
+}
+
+#ifdef NO_SEGMENTED_MEMORY
+/**
+ * Get the size of the terrain data, to get the correct size when copying later.
+ */
+u32 get_area_terrain_size(s16 *data) {
+    s16 *startPos = data;
+    s32 end = FALSE;
+    s16 terrainLoadType;
+    s32 numVertices;
+    s32 numRegions;
+    s32 numSurfaces;
+    s16 hasForce;
+
+    while (!end) {
+        terrainLoadType = *data++;
+
+        switch (terrainLoadType) {
+            case TERRAIN_LOAD_VERTICES:
+                numVertices = *data++;
+                data += 3 * numVertices;
+                break;
+
+            case TERRAIN_LOAD_OBJECTS:
+                data += get_special_objects_size(data);
+                break;
+
+            case TERRAIN_LOAD_ENVIRONMENT:
+                numRegions = *data++;
+                data += 6 * numRegions;
+                break;
+
+            case TERRAIN_LOAD_CONTINUE:
+                continue;
+
+            case TERRAIN_LOAD_END:
+                end = TRUE;
+                break;
+
+            default:
+                numSurfaces = *data++;
+                hasForce = surface_has_force(terrainLoadType);
+                data += (3 + hasForce) * numSurfaces;
+                break;
+        }
+    }
+
+    return data - startPos;
+}
+#endif
+
+/**
+ * Process the level file, loading in vertices, surfaces, some objects, and environmental
+ * boxes (water, gas, JRB fog).
+ */
+void load_area_terrain(s16 index, s16 *data, s8 *surfaceRooms, s16 *macroObjects) {
+    s16 terrainLoadType;
+    s16 *vertexData;
+    UNUSED s32 unused;
+
+    // Initialize the data for this.
+    gEnvironmentRegions = NULL;
+    unused8038BE90 = 0;
+    gSurfaceNodesAllocated = 0;
+    gSurfacesAllocated = 0;
+
+    clear_static_surfaces();
+
+    // A while loop iterating through each section of the level data. Sections of data
+    // are prefixed by a terrain "type." This type is reused for surfaces as the surface
+    // type.
+    while (TRUE) {
+        terrainLoadType = *data;
+        data++;
+
+        if (TERRAIN_LOAD_IS_SURFACE_TYPE_LOW(terrainLoadType)) {
+            load_static_surfaces(&data, vertexData, terrainLoadType, &surfaceRooms);
+        } else if (terrainLoadType == TERRAIN_LOAD_VERTICES) {
+            vertexData = read_vertex_data(&data);
+        } else if (terrainLoadType == TERRAIN_LOAD_OBJECTS) {
+            spawn_special_objects(index, &data);
+        } else if (terrainLoadType == TERRAIN_LOAD_ENVIRONMENT) {
+            load_environmental_regions(&data);
+        } else if (terrainLoadType == TERRAIN_LOAD_CONTINUE) {
+            continue;
+        } else if (terrainLoadType == TERRAIN_LOAD_END) {
+            break;
+        } else if (TERRAIN_LOAD_IS_SURFACE_TYPE_HIGH(terrainLoadType)) {
+            load_static_surfaces(&data, vertexData, terrainLoadType, &surfaceRooms);
+            continue;
+        }
+    }
+
+    // The cell layout depends on every surface of the level, so the surfaces
+    // are only added to the partition now.
+    build_static_partition();
+    clear_static_floor_cache();
+    build_environment_cells();
+#ifdef COLLISION_INSTRUMENTATION
+    clear_surface_hit_counts();
+#endif
+
+    if (macroObjects != NULL && *macroObjects != -1) {
+        // If the first macro object presetID is within the range [0, 29].
+        // Generally an early spawning method, every object is in BBH (the first level).
+        if (0 <= *macroObjects && *macroObjects < 30) {
+            spawn_macro_objects_hardcoded(index, macroObjects);
+        }
+        // A more general version that can spawn more objects.
+        else {
+            spawn_macro_objects(index, macroObjects);
+        }
+    }
+
+    gNumStaticSurfaceNodes = gSurfaceNodesAllocated;
+    gNumStaticSurfaces = gSurfacesAllocated;
+}
+
+/**
+ * If not in time stop, clear the surface partitions.
+ */
+void clear_dynamic_surfaces(void) {
+    if (!(gTimeStopState & TIME_STOP_ACTIVE)) {
+        gSurfacesAllocated = gNumStaticSurfaces;
+        gSurfaceNodesAllocated = gNumStaticSurfaceNodes;
+
+        clear_spatial_partition(&gDynamicSurfacePartition[0][0], NUM_CELLS * NUM_CELLS);
+    }
+}
+
+static void unused_80383604(void) {
+}
+
+/**
+ * Applies an object's transformation to the object's vertices.
+ */
+void transform_object_vertices(s16 **data, s16 *vertexData) {
+    register s16 *vertices;
+    register f32 vx, vy, vz;
+    register s32 numVertices;
+
+    Mat4 *objectTransform;
+    Mat4 m;
+
+    objectTransform = &gCurrentObject->transform;
+
+    numVertices = *(*data);
+    (*data)++;
+
+    vertices = *data;
+
+    if (gCurrentObject->header.gfx.throwMatrix == NULL) {
+        gCurrentObject->header.gfx.throwMatrix = objectTransform;
+        obj_build_transform_from_pos_and_angle(gCurrentObject, O_POS_INDEX, O_FACE_ANGLE_INDEX);
+    }
+
+    obj_apply_scale_to_matrix(gCurrentObject, m, *objectTransform);
+
+    // Go through all vertices, rotating and translating them to transform the object.
+    while (numVertices--) {
+        vx = *(vertices++);
+        vy = *(vertices++);
+        vz = *(vertices++);
+
+        //! No bounds check on vertex data
+        *vertexData++ = (s16)(vx * m[0][0] + vy * m[1][0] + vz * m[2][0] + m[3][0]);
+        *vertexData++ = (s16)(vx * m[0][1] + vy * m[1][1] + vz * m[2][1] + m[3][1]);
+        *vertexData++ = (s16)(vx * m[0][2] + vy * m[1][2] + vz * m[2][2] + m[3][2]);
+    }
+
+    *data = vertices;
+}
+
+/**
+ * Load in the surfaces for the gCurrentObject. This includes setting the flags, exertion, and room.
+ */
+void load_object_surfaces(s16 **data, s16 *vertexData) {
+    s32 surfaceType;
+    s32 i;
+    s32 numSurfaces;
+    s16 hasForce;
+    s16 flags;
+    s16 room;
+
+    surfaceType = *(*data);
+    (*data)++;
+
+    numSurfaces = *(*data);
+    (*data)++;
+
+    hasForce = surface_has_force(surfaceType);
+
+    flags = surf_has_no_cam_collision(surfaceType);
+    flags |= SURFACE_FLAG_DYNAMIC;
+#if WALL_ROUTINE_TIER == WALL_TIER_HYBRID
+    // Object walls move, so all of their edges are rounded.
+    flags |= SURFACE_FLAGS_CONVEX_EDGES;
+#endif
+
+    // The DDD warp is initially loaded at the origin and moved to the proper
+    // position in paintings.c and doesn't update its room, so set it here.
+    if (gCurrentObject->behavior == segmented_to_virtual(bhvDddWarp)) {
+        room = 5;
+    } else {
+        room = 0;
+    }
+
+    for (i = 0; i < numSurfaces; i++) {
+        struct Surface *surface = read_surface_data(vertexData, data);
+
+        if (surface != NULL) {
+            surface->object = gCurrentObject;
+            surface->type = surfaceType;
+
+            if (hasForce) {
+                surface->force = *(*data + 3);
+            } else {
+                surface->force = 0;
+            }
+            set_wall_yaw(surface);
+            set_ceil_bottom(surface);
+
+            surface->flags |= flags;
+            surface->room = (s8) room;
+            add_dynamic_surface(surface);
+        }
+
+        if (hasForce) {
+            *data += 4;
+        } else {
+            *data += 3;
+        }
+    }
+}
+
+/**
+ * Transform an object's vertices, reload them, and render the object.
+ */
+void load_object_collision_model(void) {
+    UNUSED s32 unused;
+    s16 vertexData[600];
+
+    s16 *collisionData = gCurrentObject->collisionData;
+    f32 marioDist = gCurrentObject->oDistanceToMario;
+    f32 tangibleDist = gCurrentObject->oCollisionDistance;
+
+    // On an object's first frame, the distance is set to 19000.0f.
+    // If the distance hasn't been updated, update it now.
+    if (gCurrentObject->oDistanceToMario == 19000.0f) {
+        marioDist = dist_between_objects(gCurrentObject, gMarioObject);
+    }
+
+    // If the object collision is supposed to be loaded more than the
+    // drawing distance of 4000, extend the drawing range.
+    if (gCurrentObject->oCollisionDistance > 4000.0f) {
+        gCurrentObject->oDrawingDistance = gCurrentObject->oCollisionDistance;
+    }
+
+    // Update if no Time Stop, in range, and in the current room.
+    if (!(gTimeStopState & TIME_STOP_ACTIVE) && marioDist < tangibleDist
+        && !(gCurrentObject->activeFlags & ACTIVE_FLAG_IN_DIFFERENT_ROOM)) {
+        collisionData++;
+        transform_object_vertices(&collisionData, vertexData);
+
+        // TERRAIN_LOAD_CONTINUE acts as an "end" term for these surfaces.
+        while (*collisionData != TERRAIN_LOAD_CONTINUE) {
+            load_object_surfaces(&collisionData, vertexData);
+        }
+    }
+
+    if (marioDist < gCurrentObject->oDrawingDistance) {
+        gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_ACTIVE;
+    } else {
+        gCurrentObject->header.gfx.node.flags &= ~GRAPH_RENDER_ACTIVE;
+    }
+}
@@ -0,0 +1,215 @@
+#ifndef SURFACE_LOAD_H
+#define SURFACE_LOAD_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+#define NUM_CELLS       (2 * LEVEL_BOUNDARY_MAX / CELL_SIZE)
+#define NUM_CELLS_INDEX (NUM_CELLS - 1)
+
+#define SURFACE_POOL_SIZE      2300
+#define SURFACE_NODE_POOL_SIZE 7000
+
+/**
+ * Static level geometry uses an adaptive partition. Each of the NUM_CELLS x NUM_CELLS
+ * cells is split into 4^n leaf cells (n <= STATIC_CELL_MAX_SUBDIVISION), chosen at load
+ * time from the number of surfaces in the cell. A maximum subdivision of 0 gives the
+ * fixed 16x16 grid.
+ */
+#define STATIC_CELL_MAX_SUBDIVISION 2
+// A cell is subdivided while its leaves would hold more surfaces than this on average.
+#define STATIC_CELL_SURFACE_LIMIT   32
+// Surface nodes the static partition may use, the rest is left for object surfaces.
+#define STATIC_SURFACE_NODE_BUDGET  (SURFACE_NODE_POOL_SIZE - 1500)
+
+/**
+ * Walls of every cell are further split into NUM_WALL_BANDS lists by height, and a
+ * wall is added to every band its lowerY..upperY range overlaps. The bands evenly
+ * cover the height range of the level's walls, object walls reuse the same bands.
+ * A cell holds 2 + NUM_WALL_BANDS list heads instead of 3, which takes
+ * gDynamicSurfacePartition from 6 KB to 20 KB with 8 byte nodes.
+ */
+#define NUM_WALL_BANDS 8
+
+// Entries of the per-cell environment region lists, summed over all cells.
+#define ENVIRONMENT_CELL_REGIONS_SIZE 1024
+
+/**
+ * The surfaces that one kind of query collides with.
+ */
+enum
+{
+    SURFACE_VIEW_ACTORS,              // all but camera boundaries
+    SURFACE_VIEW_THROUGH_VANISH_WALLS, // actors without vanish cap walls, for objects passing through them
+    SURFACE_VIEW_CAMERA,              // all without SURFACE_FLAG_NO_CAM_COLLISION
+    NUM_SURFACE_VIEWS
+};
+
+// Whether the queries of a view collide with a surface. Only vanish cap walls can be
+// passed through, not floors or ceilings of that type.
+#define SURFACE_IS_IN_VIEW(surface, view)                                                   \
+    ((view) == SURFACE_VIEW_CAMERA                                                          \
+         ? !((surface)->flags & SURFACE_FLAG_NO_CAM_COLLISION)                              \
+         : (surface)->type != SURFACE_CAMERA_BOUNDARY                                       \
+               && !((view) == SURFACE_VIEW_THROUGH_VANISH_WALLS                             \
+                    && (surface)->type == SURFACE_VANISH_CAP_WALLS                          \
+                    && (surface)->normal.y <= 0.01 && (surface)->normal.y >= -0.01))
+
+/**
+ * With SURFACE_VIEW_LINKS every list of a cell is a chain through the same nodes for
+ * each view. The chains keep the list's order, so a query follows the chain of its
+ * view and never sees the surfaces it would skip. This doubles a node from 8 to 16
+ * bytes on N64, taking the node pool from 56 KB to 112 KB and
+ * gDynamicSurfacePartition from 20 KB to 40 KB, so it is only on by default in host
+ * builds. Otherwise every view follows the one chain of all surfaces and the queries
+ * skip the surfaces not in their view as they go.
+ */
+#ifndef TARGET_N64
+#define SURFACE_VIEW_LINKS
+#endif
+
+#ifdef SURFACE_VIEW_LINKS
+#define NUM_SURFACE_VIEW_CHAINS NUM_SURFACE_VIEWS
+
+struct SurfaceNode
+{
+    struct SurfaceNode *next; // next node of the actor view
+    struct Surface *surface;
+    struct SurfaceNode *nextInView[NUM_SURFACE_VIEWS - 1]; // next node of the other views
+};
+
+// The link from a node to the next node of a view, can be assigned to.
+#define SURFACE_NODE_NEXT(node, view) \
+    (*((view) == SURFACE_VIEW_ACTORS ? &(node)->next : &(node)->nextInView[(view) - 1]))
+
+// Whether the chain of a view holds a surface, and whether a query following the
+// chain has to skip a surface on it.
+#define SURFACE_CHAIN_HOLDS(surface, view) SURFACE_IS_IN_VIEW(surface, view)
+#define SURFACE_CHAIN_SKIPS(surface, view) FALSE
+#else
+#define NUM_SURFACE_VIEW_CHAINS 1
+
+struct SurfaceNode
+{
+    struct SurfaceNode *next;
+    struct Surface *surface;
+};
+
+#define SURFACE_NODE_NEXT(node, view) ((node)->next)
+
+#define SURFACE_CHAIN_HOLDS(surface, view) TRUE
+#define SURFACE_CHAIN_SKIPS(surface, view) (!SURFACE_IS_IN_VIEW(surface, view))
+#endif
+
+// The yaw a wall faces, atan2s(normal.z, normal.x). Set when the wall is loaded and
+// kept in force, which only floors use.
+#define SURFACE_WALL_YAW(surface) ((surface)->force)
+
+// The corners of ceilings other than hangable ones are moved laterally by this margin
+// before the point is tested, see add_ceil_margin.
+#define CEIL_MARGIN 1.5f
+
+// The lowest height a ceiling can be found at, with its corners moved by CEIL_MARGIN.
+// Ceiling lists are sorted by it. Set when the ceiling is loaded and kept in force.
+#define SURFACE_CEIL_BOTTOM(surface) ((surface)->force)
+
+/**
+ * How much of a wall find_wall_collisions_from_list pushes out of. WALL_TIER_FULL
+ * rounds all three edges, WALL_TIER_FACE only pushes out of the face and
+ * WALL_TIER_HYBRID only rounds the edges the loader marked as convex.
+ */
+#define WALL_TIER_FULL   0
+#define WALL_TIER_FACE   1
+#define WALL_TIER_HYBRID 2
+
+#ifndef WALL_ROUTINE_TIER
+#define WALL_ROUTINE_TIER WALL_TIER_FULL
+#endif
+
+// Edges of a wall that stick out, the only edges rounded with WALL_TIER_HYBRID.
+#define SURFACE_FLAG_CONVEX_EDGE_1_2 (1 << 4)
+#define SURFACE_FLAG_CONVEX_EDGE_1_3 (1 << 5)
+#define SURFACE_FLAG_CONVEX_EDGE_2_3 (1 << 6)
+#define SURFACE_FLAGS_CONVEX_EDGES \
+    (SURFACE_FLAG_CONVEX_EDGE_1_2 | SURFACE_FLAG_CONVEX_EDGE_1_3 | SURFACE_FLAG_CONVEX_EDGE_2_3)
+
+enum
+{
+    SPATIAL_PARTITION_FLOORS,
+    SPATIAL_PARTITION_CEILS,
+    SPATIAL_PARTITION_WALLS, // first of NUM_WALL_BANDS wall lists, lowest band first
+    NUM_SPATIAL_PARTITIONS = SPATIAL_PARTITION_WALLS + NUM_WALL_BANDS
+};
+
+typedef struct SurfaceNode SpatialPartitionCell[NUM_SPATIAL_PARTITIONS];
+
+//#define SURFACE_SOA
+
+#ifdef SURFACE_SOA
+/**
+ * With SURFACE_SOA the lists of the static partition are also stored as arrays, one
+ * range of entries per list and view. The fields that the searches cull with are kept in arrays
+ * of their own, so those loops read memory in order instead of following nodes to
+ * scattered surfaces, and the surface itself is only read for the surfaces left.
+ * A surface in several views is stored once per view, so the arrays take
+ * NUM_SURFACE_VIEWS * SURFACE_NODE_POOL_SIZE entries of 24 bytes (28 with 64 bit
+ * pointers) from the main pool, about 500 KB. Meant for host builds.
+ */
+struct SurfaceArrayRange
+{
+    u16 start;
+    u16 count;
+};
+
+// Entries of the arrays, a node in both views is copied into each view's range.
+#define SURFACE_ARRAY_SIZE (NUM_SURFACE_VIEWS * SURFACE_NODE_POOL_SIZE)
+
+typedef struct SurfaceArrayRange SpatialPartitionRanges[NUM_SURFACE_VIEWS][NUM_SPATIAL_PARTITIONS];
+
+struct SurfaceArrays
+{
+    s16 *lowerY;
+    s16 *upperY;
+    f32 *normalX;
+    f32 *normalY;
+    f32 *normalZ;
+    f32 *originOffset;
+    struct Surface **surface;
+};
+#endif
+
+struct StaticCell
+{
+    /*0x00*/ s16 subdivision; // log2 of the number of leaf cells per axis
+    /*0x02*/ s16 firstLeaf;   // index of the first leaf cell in gStaticSurfacePartition
+};
+
+// Needed for bs bss reordering memes.
+extern s32 unused8038BE90;
+
+extern struct StaticCell gStaticCells[NUM_CELLS][NUM_CELLS];
+extern SpatialPartitionCell *gStaticSurfacePartition;
+extern SpatialPartitionCell gDynamicSurfacePartition[NUM_CELLS][NUM_CELLS];
+#ifdef SURFACE_SOA
+extern SpatialPartitionRanges *gStaticSurfaceRanges;
+extern struct SurfaceArrays gStaticSurfaceArrays;
+#endif
+extern s16 gWallBandBottom;
+extern s16 gWallBandShift;
+extern s16 gEnvironmentCellStart[NUM_CELLS * NUM_CELLS + 1];
+extern s16 gEnvironmentCellRegions[ENVIRONMENT_CELL_REGIONS_SIZE];
+extern s16 gEnvironmentCellsValid;
+extern struct SurfaceNode *sSurfaceNodePool;
+extern struct Surface *sSurfacePool;
+extern s16 sSurfacePoolSize;
+
+void alloc_surface_pools(void);
+#ifdef NO_SEGMENTED_MEMORY
+u32 get_area_terrain_size(s16 *data);
+#endif
+void load_area_terrain(s16 index, s16 *data, s8 *surfaceRooms, s16 *macroObjects);
+void clear_dynamic_surfaces(void);
+void load_object_collision_model(void);
+
+#endif // SURFACE_LOAD_H